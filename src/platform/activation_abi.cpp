@@ -1,6 +1,8 @@
 #include "pal_internal.h"
 #include "opaque_string_wrapper.h"
 #include "platform_activation.h"
+#include "activation_cache.h"
+#include "activation_registry.h"
 
 namespace xlang::impl
 {
@@ -9,7 +11,17 @@ namespace xlang::impl
         xlang_string class_name,
         xlang_guid const& iid)
     {
-        for (auto current_namespace = enclosing_namespace(to_string_view<char_type>(class_name));
+        auto const name = to_string_view<char_type>(class_name);
+        if (has_registered_activation_funcs())
+        {
+            // Registered functions, from the class itself outwards, before any library is probed
+            if (void* factory = try_registered_activation_funcs(name, class_name, iid))
+            {
+                return factory;
+            }
+        }
+
+        for (auto current_namespace = enclosing_namespace(name);
             !current_namespace.empty();
             current_namespace = enclosing_namespace(current_namespace))
         {
@@ -46,6 +58,13 @@ try
         xlang::throw_result(xlang_error_invalid_arg);
     }
 
+    auto& cache = activation_factory_cache::instance();
+    *factory = cache.find(*from_handle(class_name), iid);
+    if (*factory)
+    {
+        return xlang_error_ok;
+    }
+
     auto const encoding = xlang_get_string_encoding(class_name);
     if (encoding == (xlang_string_encoding::utf8 | xlang_string_encoding::utf16))
     {
@@ -60,10 +79,79 @@ try
         *factory = get_activation_factory<char16_t>(class_name, iid);
     }
 
+    cache.insert(*from_handle(class_name), iid, *factory);
     return xlang_error_ok;
 }
 catch (...)
 {
     *factory = nullptr;
     return xlang::to_result();
-}
\ No newline at end of file
+}
+
+XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_register_activation_factory(
+    char const* class_name_prefix,
+    xlang_pfn_lib_get_activation_factory pfn
+) XLANG_NOEXCEPT
+try
+{
+    if (!class_name_prefix || !pfn)
+    {
+        xlang::throw_result(xlang_error_pointer);
+    }
+
+    std::string_view const prefix{ class_name_prefix };
+    if (prefix.empty() || prefix.front() == '.' || prefix.back() == '.')
+    {
+        xlang::throw_result(xlang_error_invalid_arg);
+    }
+    register_activation_func(prefix, pfn);
+    return xlang_error_ok;
+}
+catch (...)
+{
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_invalidate_activation_factory_cache(
+    xlang_string class_name_prefix
+) XLANG_NOEXCEPT
+try
+{
+    activation_factory_cache::instance().invalidate(from_handle(class_name_prefix));
+    return xlang_error_ok;
+}
+catch (...)
+{
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_get_activation_factory_cache_stats(
+    xlang_activation_factory_cache_stats* stats
+) XLANG_NOEXCEPT
+{
+    if (!stats)
+    {
+        return xlang_error_pointer;
+    }
+
+    auto const& cache = activation_factory_cache::instance();
+    stats->hits = cache.hits();
+    stats->misses = cache.misses();
+    stats->entries = cache.size();
+    return xlang_error_ok;
+}
+
+#if !XLANG_PLATFORM_WINDOWS
+XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_set_activation_search_path(
+    char const* search_path
+) XLANG_NOEXCEPT
+try
+{
+    set_activation_search_path(search_path);
+    return xlang_error_ok;
+}
+catch (...)
+{
+    return xlang::to_result();
+}
+#endif
@@ -0,0 +1,313 @@
+#include "activation_cache.h"
+#include <string.h>
+#include <algorithm>
+#include <iterator>
+#include <string_view>
+#include <thread>
+
+namespace xlang::impl
+{
+    namespace
+    {
+        // Class name code units in the string's own encoding, viewed as bytes.
+        struct class_key
+        {
+            std::string_view bytes;
+            bool is_utf8;
+        };
+
+        class_key make_key(string_base const& class_name) noexcept
+        {
+            if (class_name.is_utf8())
+            {
+                return { { reinterpret_cast<char const*>(class_name.get_buffer<xlang_char8>()), class_name.get_length() }, true };
+            }
+            return { { reinterpret_cast<char const*>(class_name.get_buffer<char16_t>()), class_name.get_length() * sizeof(char16_t) }, false };
+        }
+
+        // FNV-1a over the name and IID
+        size_t hash_key(class_key const& key, xlang_guid const& iid) noexcept
+        {
+            uint64_t hash = 14695981039346656037ull;
+            auto const mix = [&hash](void const* data, size_t size)
+            {
+                auto bytes = static_cast<uint8_t const*>(data);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    hash = (hash ^ bytes[i]) * 1099511628211ull;
+                }
+            };
+            mix(key.bytes.data(), key.bytes.size());
+            mix(&iid, sizeof(iid));
+            return static_cast<size_t>(hash ^ key.is_utf8);
+        }
+
+        bool is_in_namespace(std::basic_string_view<char> name, std::basic_string_view<char> prefix) noexcept
+        {
+            return name.size() >= prefix.size()
+                && name.compare(0, prefix.size(), prefix) == 0
+                && (name.size() == prefix.size() || name[prefix.size()] == '.');
+        }
+
+        bool is_in_namespace(std::basic_string_view<char16_t> name, std::basic_string_view<char16_t> prefix) noexcept
+        {
+            return name.size() >= prefix.size()
+                && name.compare(0, prefix.size(), prefix) == 0
+                && (name.size() == prefix.size() || name[prefix.size()] == u'.');
+        }
+
+        void add_ref(void* factory) noexcept
+        {
+            auto unknown = static_cast<unknown_abi*>(factory);
+            unknown->vtable->add_ref(unknown);
+        }
+
+        void release(void* factory) noexcept
+        {
+            auto unknown = static_cast<unknown_abi*>(factory);
+            unknown->vtable->release(unknown);
+        }
+
+        constexpr uint32_t initial_capacity = 64;
+    }
+
+    struct activation_factory_cache::entry
+    {
+        size_t hash;
+        xlang_guid iid;
+        bool is_utf8;
+        std::string name;
+        void* factory;
+
+        bool matches(size_t other_hash, class_key const& key, xlang_guid const& other_iid) const noexcept
+        {
+            return hash == other_hash
+                && is_utf8 == key.is_utf8
+                && std::string_view{ name } == key.bytes
+                && memcmp(&iid, &other_iid, sizeof(iid)) == 0;
+        }
+
+        bool in_namespace(std::basic_string_view<xlang_char8> prefix_utf8, std::basic_string_view<char16_t> prefix_utf16) const noexcept
+        {
+            if (is_utf8)
+            {
+                return is_in_namespace(std::basic_string_view<char>{ name }, { reinterpret_cast<char const*>(prefix_utf8.data()), prefix_utf8.size() });
+            }
+            return is_in_namespace(std::basic_string_view<char16_t>{ reinterpret_cast<char16_t const*>(name.data()), name.size() / sizeof(char16_t) }, prefix_utf16);
+        }
+    };
+
+    struct activation_factory_cache::table
+    {
+        explicit table(uint32_t capacity)
+            : slots(std::make_unique<std::atomic<entry*>[]>(capacity))
+            , mask(capacity - 1)
+        {
+            XLANG_ASSERT((capacity & mask) == 0);
+        }
+
+        uint32_t capacity() const noexcept
+        {
+            return mask + 1;
+        }
+
+        std::unique_ptr<std::atomic<entry*>[]> slots;
+        uint32_t mask;
+    };
+
+    activation_factory_cache& activation_factory_cache::instance() noexcept
+    {
+        // Intentionally leaked; see the comment on the class.
+        static activation_factory_cache* cache = new activation_factory_cache();
+        return *cache;
+    }
+
+    activation_factory_cache::activation_factory_cache()
+        : current_owner(std::make_unique<table>(initial_capacity))
+    {
+        current.store(current_owner.get(), std::memory_order_release);
+    }
+
+    uint32_t activation_factory_cache::enter_read() noexcept
+    {
+        // If a writer flips the phase between the load and the increment, it may already have finished waiting
+        // on that counter, so back out and join the new phase instead.
+        for (;;)
+        {
+            uint32_t const phase = read_phase.load();
+            reader_counts[phase].fetch_add(1);
+            if (read_phase.load() == phase)
+            {
+                return phase;
+            }
+            reader_counts[phase].fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    void activation_factory_cache::leave_read(uint32_t phase) noexcept
+    {
+        reader_counts[phase].fetch_sub(1, std::memory_order_release);
+    }
+
+    void* activation_factory_cache::find(string_base const& class_name, xlang_guid const& iid) noexcept
+    {
+        auto const key = make_key(class_name);
+        size_t const hash = hash_key(key, iid);
+        void* factory{};
+
+        uint32_t const phase = enter_read();
+        table const& slots = *current.load(std::memory_order_acquire);
+        for (size_t i = hash & slots.mask;; i = (i + 1) & slots.mask)
+        {
+            entry const* value = slots.slots[i].load(std::memory_order_acquire);
+            if (!value)
+            {
+                break;
+            }
+            if (value->matches(hash, key, iid))
+            {
+                factory = value->factory;
+                add_ref(factory);
+                break;
+            }
+        }
+        leave_read(phase);
+
+        (factory ? hit_count : miss_count).fetch_add(1, std::memory_order_relaxed);
+        return factory;
+    }
+
+    void activation_factory_cache::insert(string_base const& class_name, xlang_guid const& iid, void* factory)
+    {
+        auto const key = make_key(class_name);
+        size_t const hash = hash_key(key, iid);
+
+        std::lock_guard lock{ write_mutex };
+        table* target = current.load(std::memory_order_relaxed);
+        for (size_t i = hash & target->mask;; i = (i + 1) & target->mask)
+        {
+            entry const* value = target->slots[i].load(std::memory_order_relaxed);
+            if (!value)
+            {
+                break;
+            }
+            if (value->matches(hash, key, iid))
+            {
+                return;
+            }
+        }
+
+        auto new_entry = std::make_unique<entry>(entry{ hash, iid, key.is_utf8, std::string{ key.bytes }, factory });
+        entries.reserve(entries.size() + 1);
+
+        // Keep at least half the slots empty, so probes stay short and always end.
+        if ((entries.size() + 1) * 2 > target->capacity())
+        {
+            publish(rebuild(1));
+            target = current.load(std::memory_order_relaxed);
+        }
+
+        add_ref(factory);
+        insert_into(*target, new_entry.get());
+        entries.push_back(std::move(new_entry));
+    }
+
+    void activation_factory_cache::invalidate(string_base const* prefix)
+    {
+        std::basic_string_view<xlang_char8> prefix_utf8;
+        std::basic_string_view<char16_t> prefix_utf16;
+        if (prefix)
+        {
+            // const_cast: ensure_buffer only attaches a cached alternate, it doesn't change the string.
+            prefix_utf8 = const_cast<string_base*>(prefix)->ensure_buffer<xlang_char8>();
+            prefix_utf16 = const_cast<string_base*>(prefix)->ensure_buffer<char16_t>();
+        }
+
+        std::vector<std::unique_ptr<entry>> removed;
+        {
+            std::lock_guard lock{ write_mutex };
+            auto const affected = std::stable_partition(entries.begin(), entries.end(), [&](auto const& value)
+            {
+                return prefix && !value->in_namespace(prefix_utf8, prefix_utf16);
+            });
+            if (affected == entries.end())
+            {
+                return;
+            }
+
+            removed.reserve(entries.end() - affected);
+            std::move(affected, entries.end(), std::back_inserter(removed));
+            entries.erase(affected, entries.end());
+
+            // Once the rebuilt table is published and the readers have drained, nothing can reach the removed
+            // entries or their factories.
+            publish(rebuild(0));
+        }
+
+        // Released outside the lock, in case a factory's destructor activates something itself.
+        for (auto const& value : removed)
+        {
+            release(value->factory);
+        }
+    }
+
+    uint64_t activation_factory_cache::hits() const noexcept
+    {
+        return hit_count.load(std::memory_order_relaxed);
+    }
+
+    uint64_t activation_factory_cache::misses() const noexcept
+    {
+        return miss_count.load(std::memory_order_relaxed);
+    }
+
+    uint32_t activation_factory_cache::size() const noexcept
+    {
+        std::lock_guard lock{ write_mutex };
+        return static_cast<uint32_t>(entries.size());
+    }
+
+    void activation_factory_cache::insert_into(table& target, entry* value) noexcept
+    {
+        for (size_t i = value->hash & target.mask;; i = (i + 1) & target.mask)
+        {
+            if (!target.slots[i].load(std::memory_order_relaxed))
+            {
+                target.slots[i].store(value, std::memory_order_release);
+                return;
+            }
+        }
+    }
+
+    std::unique_ptr<activation_factory_cache::table> activation_factory_cache::rebuild(uint32_t extra)
+    {
+        uint32_t capacity = initial_capacity;
+        while (capacity < (entries.size() + extra) * 4)
+        {
+            capacity *= 2;
+        }
+
+        auto replacement = std::make_unique<table>(capacity);
+        for (auto const& value : entries)
+        {
+            insert_into(*replacement, value.get());
+        }
+        return replacement;
+    }
+
+    void activation_factory_cache::publish(std::unique_ptr<table> replacement)
+    {
+        current.store(replacement.get());
+
+        // Lookups that started in the previous phase may still be probing the old table. Later ones either
+        // join the new phase or see it change and retry, and in both cases load the new table.
+        uint32_t const previous = read_phase.load(std::memory_order_relaxed);
+        read_phase.store(previous ^ 1);
+        while (reader_counts[previous].load() != 0)
+        {
+            std::this_thread::yield();
+        }
+
+        current_owner = std::move(replacement);
+    }
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "pal_internal.h"
+#include "string_base.h"
+
+namespace xlang::impl
+{
+    // The IUnknown prefix shared by every xlang interface, enough to manage factory lifetimes.
+    struct unknown_abi
+    {
+        struct vtable_type
+        {
+            xlang_result(XLANG_CALL* query_interface)(unknown_abi*, xlang_guid const&, void**) noexcept;
+            uint32_t(XLANG_CALL* add_ref)(unknown_abi*) noexcept;
+            uint32_t(XLANG_CALL* release)(unknown_abi*) noexcept;
+        };
+
+        vtable_type const* vtable;
+    };
+
+    // Caches activation factories by (class name, IID), so repeated requests skip the library lookup and the
+    // call into the component. Each entry holds one reference on its factory.
+    //
+    // Lookups are lock-free: they probe an open-addressed table of atomic entry pointers, and entries are never
+    // modified once published. Writers serialize on a mutex and publish a rebuilt table rather than mutating one
+    // a reader can see. A replaced table, and any entries it alone referenced, are freed once every lookup that
+    // might still be using it has finished. Readers announce themselves in one of two counters, and a writer
+    // flips the active counter and waits for the other one to drain.
+    //
+    // The cache itself is never destroyed, because releasing factories during process teardown would call into
+    // libraries that may already be gone.
+    //
+    // Class names are keyed in the encoding they were created with, so a class requested with both UTF-8 and
+    // UTF-16 names gets an entry for each, and lookups never transcode.
+    struct activation_factory_cache
+    {
+        static activation_factory_cache& instance() noexcept;
+
+        // Returns a new reference to the cached factory, or null on a miss.
+        void* find(string_base const& class_name, xlang_guid const& iid) noexcept;
+
+        // Adds a factory the caller holds a reference to. The cache takes its own reference. If another thread
+        // inserted the same key first, the existing entry wins.
+        void insert(string_base const& class_name, xlang_guid const& iid, void* factory);
+
+        // Removes and releases entries for classes in the given namespace (the class itself, or anything nested
+        // under "prefix."). A null prefix removes everything. Callers must ensure the affected classes are not
+        // activated concurrently, as for a library that is about to be unloaded.
+        void invalidate(string_base const* prefix);
+
+        uint64_t hits() const noexcept;
+        uint64_t misses() const noexcept;
+        uint32_t size() const noexcept;
+
+    private:
+        struct entry;
+        struct table;
+
+        activation_factory_cache();
+
+        uint32_t enter_read() noexcept;
+        void leave_read(uint32_t phase) noexcept;
+
+        void insert_into(table& target, entry* value) noexcept;
+        std::unique_ptr<table> rebuild(uint32_t extra);
+        void publish(std::unique_ptr<table> replacement);
+
+        std::atomic<table*> current{};
+
+        mutable std::mutex write_mutex;
+        std::unique_ptr<table> current_owner;
+        std::vector<std::unique_ptr<entry>> entries;
+
+        // Lookups in progress, split by the phase they started in.
+        alignas(64) std::atomic<uint32_t> read_phase{};
+        std::atomic<uint32_t> reader_counts[2]{};
+
+        // Kept on their own cache lines so counting hits doesn't contend with the table pointer.
+        alignas(64) std::atomic<uint64_t> hit_count{};
+        alignas(64) std::atomic<uint64_t> miss_count{};
+    };
+}
@@ -0,0 +1,121 @@
+#include "activation_registry.h"
+#include "platform_activation.h"
+#include "string_convert.h"
+#include <atomic>
+#include <memory>
+#include <string>
+
+namespace xlang::impl
+{
+    namespace
+    {
+        struct registration
+        {
+            registration* next;
+            xlang_pfn_lib_get_activation_factory pfn;
+            uint32_t hash;
+            std::string const prefix;
+        };
+
+        constexpr size_t bucket_count = 256;
+
+        // Zero-initialized before any dynamic initialization runs, so components can register from their own
+        // static initializers regardless of the order translation units are initialized in.
+        std::atomic<registration*> buckets[bucket_count]{};
+        std::atomic<uint32_t> registration_count{};
+
+        // FNV-1a
+        uint32_t hash_prefix(std::string_view value) noexcept
+        {
+            uint32_t hash = 0x811C9DC5;
+            for (char c : value)
+            {
+                hash = (hash ^ static_cast<uint8_t>(c)) * 0x01000193;
+            }
+            return hash;
+        }
+
+        void* try_prefix(std::string_view prefix, xlang_string class_name, xlang_guid const& iid)
+        {
+            uint32_t const hash = hash_prefix(prefix);
+            for (registration* entry = buckets[hash % bucket_count].load(std::memory_order_acquire); entry; entry = entry->next)
+            {
+                if (entry->hash != hash || entry->prefix != prefix)
+                {
+                    continue;
+                }
+
+                void* factory{};
+                xlang_result const result = (*entry->pfn)(class_name, iid, &factory);
+                if (result == xlang_error_ok)
+                {
+                    return factory;
+                }
+                else if (result != xlang_error_class_not_available)
+                {
+                    throw_result(result);
+                }
+            }
+            return nullptr;
+        }
+    }
+
+    void register_activation_func(std::string_view class_name_prefix, xlang_pfn_lib_get_activation_factory pfn)
+    {
+        uint32_t const hash = hash_prefix(class_name_prefix);
+        auto entry = new registration{ nullptr, pfn, hash, std::string{ class_name_prefix } };
+
+        auto& head = buckets[hash % bucket_count];
+        registration* current = head.load(std::memory_order_relaxed);
+        do
+        {
+            entry->next = current;
+        } while (!head.compare_exchange_weak(current, entry, std::memory_order_release, std::memory_order_relaxed));
+
+        registration_count.fetch_add(1, std::memory_order_release);
+    }
+
+    void* try_registered_activation_funcs(
+        std::basic_string_view<xlang_char8> class_name,
+        xlang_string class_name_handle,
+        xlang_guid const& iid)
+    {
+        static_assert(sizeof(xlang_char8) == sizeof(char));
+        for (std::string_view prefix{ reinterpret_cast<char const*>(class_name.data()), class_name.size() };
+            !prefix.empty();
+            prefix = enclosing_namespace(prefix))
+        {
+            if (void* factory = try_prefix(prefix, class_name_handle, iid))
+            {
+                return factory;
+            }
+        }
+        return nullptr;
+    }
+
+    void* try_registered_activation_funcs(
+        std::basic_string_view<char16_t> class_name,
+        xlang_string class_name_handle,
+        xlang_guid const& iid)
+    {
+        constexpr uint32_t max_stack_length = 256;
+        auto const length = get_converted_length(class_name);
+        if (length < max_stack_length)
+        {
+            xlang_char8 converted_name[max_stack_length];
+            uint32_t converted_length = convert_string(class_name, converted_name, max_stack_length);
+            return try_registered_activation_funcs({ converted_name, converted_length }, class_name_handle, iid);
+        }
+        else
+        {
+            auto converted_name = std::make_unique<xlang_char8[]>(length);
+            uint32_t converted_length = convert_string(class_name, converted_name.get(), length);
+            return try_registered_activation_funcs({ converted_name.get(), converted_length }, class_name_handle, iid);
+        }
+    }
+
+    bool has_registered_activation_funcs() noexcept
+    {
+        return registration_count.load(std::memory_order_acquire) != 0;
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "pal_internal.h"
+#include <string_view>
+
+namespace xlang::impl
+{
+    // Activation functions registered with xlang_register_activation_factory, keyed by the class name prefix
+    // (a namespace, or a full class name) they were registered under. Safe to use during static
+    // initialization, from any translation unit: the table is constant-initialized.
+    //
+    // Registration and lookup are lock-free. Each bucket is a list that registration prepends to with a
+    // compare-exchange; nothing is ever removed, since registered functions belong to code linked into the
+    // process for its whole lifetime.
+    void register_activation_func(std::string_view class_name_prefix, xlang_pfn_lib_get_activation_factory pfn);
+
+    // Walks the class name and then its enclosing namespaces, innermost first. At each level, calls the functions
+    // registered under exactly that prefix, newest first, until one produces a factory, which is returned.
+    // Returns null if none does. Errors other than xlang_error_class_not_available are thrown.
+    //
+    // Registered prefixes are UTF-8, so a UTF-16 class name is converted once, up front, and the walk then
+    // shortens views of the converted name.
+    void* try_registered_activation_funcs(
+        std::basic_string_view<xlang_char8> class_name,
+        xlang_string class_name_handle,
+        xlang_guid const& iid);
+
+    void* try_registered_activation_funcs(
+        std::basic_string_view<char16_t> class_name,
+        xlang_string class_name_handle,
+        xlang_guid const& iid);
+
+    bool has_registered_activation_funcs() noexcept;
+}
@@ -11,6 +11,10 @@ namespace xlang::impl
         int32_t operator++() noexcept;
         int32_t operator--() noexcept;
 
+        // Adds a reference unless the count has already reached zero, for objects that can be found through a
+        // table rather than only through an existing reference.
+        bool try_increment() noexcept;
+
         int32_t get_count() const noexcept;
 
     private:
@@ -45,6 +49,19 @@ namespace xlang::impl
         return result;
     }
 
+    inline bool atomic_ref_count::try_increment() noexcept
+    {
+        int32_t current = count.load(std::memory_order_relaxed);
+        do
+        {
+            if (current == 0)
+            {
+                return false;
+            }
+        } while (!count.compare_exchange_weak(current, current + 1, std::memory_order_relaxed));
+        return true;
+    }
+
     inline int32_t atomic_ref_count::get_count() const noexcept
     {
         return count.load(std::memory_order_acquire);
@@ -4,23 +4,24 @@
 #include "pal_internal.h"
 #include "atomic_ref_count.h"
 #include "string_allocate.h"
+#include "string_allocator.h"
 #include "string_convert.h"
 #include "string_traits.h"
 
 namespace xlang::impl
 {
-    struct xlang_mem_deleter
-    {
-        void operator()(void* ptr) const noexcept
-        {
-            xlang_mem_free(ptr);
-        }
-    };
-
     struct cache_string
     {
         template <typename char_type>
-        static std::unique_ptr<cache_string, xlang_mem_deleter> create(char_type const* source_string, uint32_t length);
+        static std::unique_ptr<cache_string, string_storage_deleter> create(char_type const* source_string, uint32_t length, storage_kind kind);
+
+        // Converts source_string into storage, which must hold packed_size(alternate_length) bytes, aligned
+        // for cache_string. For alternates that share an allocation with their string.
+        template <typename char_type>
+        static cache_string* create_at(void* storage, char_type const* source_string, uint32_t length, uint32_t alternate_length);
+
+        template <typename char_type>
+        static uint32_t packed_size(uint32_t alternate_length);
 
         template <typename char_type>
         char_type const* get_buffer() const noexcept;
@@ -49,31 +50,38 @@ namespace xlang::impl
     {
         if (--count == 0)
         {
-            xlang_mem_free(this);
+            free_string_storage(this);
         }
     }
 
     template <typename char_type>
-    std::unique_ptr<cache_string, xlang_mem_deleter> cache_string::create(char_type const* source_string, uint32_t length)
+    std::unique_ptr<cache_string, string_storage_deleter> cache_string::create(char_type const* source_string, uint32_t length, storage_kind kind)
     {
-        static_assert(std::disjunction_v<std::is_same<char_type, xlang_char8>, std::is_same<char_type, char16_t>>, "char_t must be either xlang_char8 or char16_t");
-        using alternate_char_type = typename alternate_type<char_type>::result_type;
         uint32_t alternate_length = get_converted_length({ source_string, length });
 
-        auto packed_size = packed_buffer_size<cache_string, alternate_char_type>(alternate_length);
+        std::unique_ptr<cache_string, string_storage_deleter> new_string{ reinterpret_cast<cache_string*>(allocate_string_storage(packed_size<char_type>(alternate_length), kind)) };
+        create_at(new_string.get(), source_string, length, alternate_length);
+        return new_string;
+    }
 
-        std::unique_ptr<cache_string, xlang_mem_deleter> new_string{ reinterpret_cast<cache_string*>(xlang_mem_alloc(packed_size)) };
-        if (!new_string)
-        {
-            throw std::bad_alloc{};
-        }
+    template <typename char_type>
+    cache_string* cache_string::create_at(void* storage, char_type const* source_string, uint32_t length, uint32_t alternate_length)
+    {
+        static_assert(std::disjunction_v<std::is_same<char_type, xlang_char8>, std::is_same<char_type, char16_t>>, "char_t must be either xlang_char8 or char16_t");
+        using alternate_char_type = typename alternate_type<char_type>::result_type;
 
-        alternate_char_type* alternate_buffer = get_packed_buffer_ptr<cache_string, alternate_char_type>(new_string.get());
+        auto new_string = static_cast<cache_string*>(storage);
+        alternate_char_type* alternate_buffer = get_packed_buffer_ptr<cache_string, alternate_char_type>(new_string);
         convert_string({ source_string, length }, alternate_buffer, alternate_length);
         alternate_buffer[alternate_length] = 0;
 
-        new (new_string.get()) cache_string(alternate_length);
-        return new_string;
+        return new (storage) cache_string(alternate_length);
+    }
+
+    template <typename char_type>
+    inline uint32_t cache_string::packed_size(uint32_t alternate_length)
+    {
+        return packed_buffer_size<cache_string, typename alternate_type<char_type>::result_type>(alternate_length);
     }
 
     template <typename char_type>
@@ -1,21 +1,179 @@
 #include "pal_internal.h"
 #include "platform_activation.h"
 #include "string_convert.h"
+#include <dlfcn.h>
+#include <stdlib.h>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#error "This file is for targeting platforms other than Windows"
+#endif
+
+using namespace std::string_view_literals;
 
 namespace xlang::impl
 {
+    namespace
+    {
+        // Resolves namespaces to the xlang_lib_get_activation_factory export of "<namespace>.so".
+        //
+        // Every namespace that has been probed is remembered, including the ones that have no library
+        // (or a library without the export), so the enclosing_namespace walk in activation_abi.cpp only
+        // touches the filesystem the first time a given namespace level is seen. Libraries are never
+        // unloaded, so cached function pointers stay valid for the lifetime of the process.
+        struct module_cache
+        {
+            xlang_pfn_lib_get_activation_factory find_or_load(std::string_view module_namespace)
+            {
+                {
+                    std::shared_lock lock{ mutex };
+                    auto it = modules.find(module_namespace);
+                    if (it != modules.end())
+                    {
+                        return it->second.pfn;
+                    }
+                }
+
+                std::unique_lock lock{ mutex };
+                auto it = modules.find(module_namespace);
+                if (it != modules.end())
+                {
+                    return it->second.pfn;
+                }
+
+                auto const pfn = load(module_namespace);
+                auto name = std::make_unique<std::string const>(module_namespace);
+                std::string_view const key{ *name };
+                modules.emplace(key, cached_module{ std::move(name), pfn });
+                return pfn;
+            }
+
+            void set_search_path(char const* search_path)
+            {
+                std::unique_lock lock{ mutex };
+                search_directories = split_search_path(search_path ? search_path : ::getenv("XLANG_ACTIVATION_PATH"));
+
+                // Namespaces that were missing may resolve under the new path. Libraries that were found
+                // stay loaded, so their entries remain valid.
+                for (auto it = modules.begin(); it != modules.end();)
+                {
+                    it = it->second.pfn ? std::next(it) : modules.erase(it);
+                }
+            }
+
+            static module_cache& instance()
+            {
+                static module_cache cache;
+                return cache;
+            }
+
+        private:
+            struct cached_module
+            {
+                std::unique_ptr<std::string const> name;
+                xlang_pfn_lib_get_activation_factory pfn;
+            };
+
+            module_cache()
+                : search_directories(split_search_path(::getenv("XLANG_ACTIVATION_PATH")))
+            {}
+
+            // Colon-separated, like LD_LIBRARY_PATH. An empty list defers to the dynamic loader's own search order.
+            static std::vector<std::string> split_search_path(char const* search_path)
+            {
+                std::vector<std::string> result;
+                std::string_view remaining{ search_path ? search_path : "" };
+                while (!remaining.empty())
+                {
+                    auto const pos = remaining.find(':');
+                    auto const directory = remaining.substr(0, pos);
+                    if (!directory.empty())
+                    {
+                        result.emplace_back(directory);
+                    }
+                    remaining = pos == remaining.npos ? std::string_view{} : remaining.substr(pos + 1);
+                }
+                return result;
+            }
+
+            xlang_pfn_lib_get_activation_factory load(std::string_view module_namespace) const
+            {
+                constexpr auto file_ext{ ".so"sv };
+                std::string file_name;
+                file_name.reserve(module_namespace.size() + file_ext.size());
+                file_name = module_namespace;
+                file_name += file_ext;
+
+                void* module{};
+                if (search_directories.empty())
+                {
+                    module = ::dlopen(file_name.c_str(), RTLD_NOW | RTLD_LOCAL);
+                }
+                else
+                {
+                    std::string path;
+                    for (auto const& directory : search_directories)
+                    {
+                        path = directory;
+                        path += '/';
+                        path += file_name;
+                        module = ::dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+                        if (module)
+                        {
+                            break;
+                        }
+                    }
+                }
+
+                if (module)
+                {
+                    return reinterpret_cast<xlang_pfn_lib_get_activation_factory>(::dlsym(module, activation_fn_name.data()));
+                }
+                return nullptr;
+            }
+
+            std::shared_mutex mutex;
+            std::vector<std::string> search_directories;
+
+            // Keys view into cached_module::name, so lookups don't need to allocate. A null pfn is a negative entry.
+            std::unordered_map<std::string_view, cached_module> modules;
+        };
+    }
+
     xlang_pfn_lib_get_activation_factory try_get_activation_func(
         std::basic_string_view<char16_t> module_namespace)
     {
-        // TODO: implement try_get_activation_func for non-windows platforms
-        throw_result(xlang_error_sadness);
+        constexpr uint32_t max_stack_length = 256;
+        auto const length = get_converted_length(module_namespace);
+        if (length < max_stack_length)
+        {
+            xlang_char8 converted_name[max_stack_length];
+            uint32_t converted_length = convert_string(module_namespace, converted_name, max_stack_length);
+            return try_get_activation_func({ converted_name, converted_length });
+        }
+        else
+        {
+            auto converted_name = std::make_unique<xlang_char8[]>(length);
+            uint32_t converted_length = convert_string(module_namespace, converted_name.get(), length);
+            return try_get_activation_func({ converted_name.get(), converted_length });
+        }
     }
 
     xlang_pfn_lib_get_activation_factory try_get_activation_func(
-        std::basic_string_view<char> module_namespace)
+        std::basic_string_view<xlang_char8> module_namespace)
     {
-        // TODO: implement try_get_activation_func for non-windows platforms
-        throw_result(xlang_error_sadness);
+        static_assert(sizeof(xlang_char8) == sizeof(char));
+        return module_cache::instance().find_or_load(
+            std::string_view{ reinterpret_cast<char const*>(module_namespace.data()), module_namespace.size() });
     }
 
-}
\ No newline at end of file
+    void set_activation_search_path(char const* search_path)
+    {
+        module_cache::instance().set_search_path(search_path);
+    }
+}
@@ -1,23 +1,35 @@
 #include <stdlib.h>
-#include "pal.h"
+#include "platform_memory.h"
 
 #ifdef _WIN32
 #error "This file is for targeting platforms other than Windows"
 #endif
 
-extern "C"
+namespace xlang::impl
 {
-    void* XLANG_CALL xlang_mem_alloc(size_t count) noexcept
+    namespace
     {
-        if (count == 0)
+        void* XLANG_CALL platform_alloc(void*, size_t count)
         {
-            count = 1;
+            return ::malloc(count);
         }
-        return ::malloc(count);
+
+        void XLANG_CALL platform_free(void*, void* ptr)
+        {
+            ::free(ptr);
+        }
+
+        void* XLANG_CALL platform_aligned_alloc(void*, size_t count, size_t alignment)
+        {
+            void* ptr{};
+            return ::posix_memalign(&ptr, alignment < sizeof(void*) ? sizeof(void*) : alignment, count) == 0 ? ptr : nullptr;
+        }
+
+        constexpr xlang_allocator platform_allocator{ nullptr, platform_alloc, platform_free, nullptr, platform_aligned_alloc, platform_free };
     }
 
-    void XLANG_CALL xlang_mem_free(void* ptr) noexcept
+    xlang_allocator const& get_platform_allocator() noexcept
     {
-        ::free(ptr);
+        return platform_allocator;
     }
 }
@@ -1,8 +1,242 @@
 #include "pal_internal.h"
 #include "string_convert.h"
+#include "simd_string_convert.h"
+#include <algorithm>
+#include <limits>
+
+#ifdef _WIN32
+#error "This file is for targeting platforms other than Windows"
+#endif
+
+// Validating UTF-8 <-> UTF-16 transcoding for non-Windows platforms.
+//
+// Runs of ASCII, runs of non-surrogate UTF-16 code units, and runs of one and two byte UTF-8 sequences
+// are handed to the vectorized kernels selected at runtime in simd_string_convert.h. Everything else
+// (surrogate pairs, three and four byte UTF-8 sequences, and anything malformed) goes through the scalar
+// code point loops below, which are also the only place where invalid input is reported.
+// A null output buffer measures the converted length without writing anything, matching the
+// WideCharToMultiByte/MultiByteToWideChar contract used by the Windows implementation.
 
 namespace xlang::impl
 {
+    namespace
+    {
+        constexpr bool is_ascii(uint32_t c) noexcept
+        {
+            return c < 0x80;
+        }
+
+        constexpr bool is_continuation(uint8_t c) noexcept
+        {
+            return (c & 0xC0) == 0x80;
+        }
+
+        constexpr bool is_high_surrogate(char16_t c) noexcept
+        {
+            return (c & 0xFC00) == 0xD800;
+        }
+
+        constexpr bool is_low_surrogate(char16_t c) noexcept
+        {
+            return (c & 0xFC00) == 0xDC00;
+        }
+
+        constexpr bool is_surrogate(char16_t c) noexcept
+        {
+            return (c & 0xF800) == 0xD800;
+        }
+
+        // Decodes one well-formed UTF-8 sequence (Unicode 11.0, table 3-7). Rejects overlong encodings,
+        // surrogate code points, values above U+10FFFF and truncated sequences.
+        inline char32_t decode_utf8(uint8_t const*& first, uint8_t const* last)
+        {
+            uint8_t const lead = *first;
+            uint32_t trailing{};
+            uint8_t min_second = 0x80;
+            uint8_t max_second = 0xBF;
+            char32_t result{};
+
+            if (lead < 0xC2)
+            {
+                // Stray continuation byte or overlong two-byte lead
+                throw_result(xlang_error_untranslatable_string);
+            }
+            else if (lead < 0xE0)
+            {
+                trailing = 1;
+                result = lead & 0x1F;
+            }
+            else if (lead < 0xF0)
+            {
+                trailing = 2;
+                result = lead & 0x0F;
+                if (lead == 0xE0)
+                {
+                    min_second = 0xA0;
+                }
+                else if (lead == 0xED)
+                {
+                    max_second = 0x9F;
+                }
+            }
+            else if (lead < 0xF5)
+            {
+                trailing = 3;
+                result = lead & 0x07;
+                if (lead == 0xF0)
+                {
+                    min_second = 0x90;
+                }
+                else if (lead == 0xF4)
+                {
+                    max_second = 0x8F;
+                }
+            }
+            else
+            {
+                throw_result(xlang_error_untranslatable_string);
+            }
+
+            if (static_cast<size_t>(last - first) <= trailing)
+            {
+                throw_result(xlang_error_untranslatable_string);
+            }
+
+            uint8_t const second = first[1];
+            if (second < min_second || second > max_second)
+            {
+                throw_result(xlang_error_untranslatable_string);
+            }
+            result = (result << 6) | (second & 0x3F);
+
+            for (uint32_t i = 2; i <= trailing; ++i)
+            {
+                if (!is_continuation(first[i]))
+                {
+                    throw_result(xlang_error_untranslatable_string);
+                }
+                result = (result << 6) | (first[i] & 0x3F);
+            }
+
+            first += trailing + 1;
+            XLANG_ASSERT(result <= 0x10FFFF);
+            return result;
+        }
+
+        inline char32_t decode_utf16(char16_t const*& first, char16_t const* last)
+        {
+            char16_t const lead = *first++;
+            if (is_high_surrogate(lead))
+            {
+                if (first == last || !is_low_surrogate(*first))
+                {
+                    throw_result(xlang_error_untranslatable_string);
+                }
+                char16_t const trail = *first++;
+                return 0x10000 + ((static_cast<char32_t>(lead - 0xD800) << 10) | (trail - 0xDC00));
+            }
+            else if (is_low_surrogate(lead))
+            {
+                throw_result(xlang_error_untranslatable_string);
+            }
+            return lead;
+        }
+
+        constexpr uint32_t utf8_length(char32_t c) noexcept
+        {
+            return c < 0x80 ? 1 : c < 0x800 ? 2 : c < 0x10000 ? 3 : 4;
+        }
+
+        constexpr uint32_t utf16_length(char32_t c) noexcept
+        {
+            return c < 0x10000 ? 1 : 2;
+        }
+
+        // Inputs shorter than this are past the point where any kernel can load a full block, so the scalar
+        // loops finish their non-ASCII runs without going back to the kernels.
+        constexpr ptrdiff_t scalar_tail = 16;
+
+        // Bounds-checked output cursor. When buffer is null, only counts.
+        template <typename char_type>
+        struct output_cursor
+        {
+            char_type* buffer;
+            uint32_t capacity;
+            uint32_t written{};
+
+            uint32_t available() const noexcept
+            {
+                return buffer ? capacity - written : std::numeric_limits<uint32_t>::max() - written;
+            }
+
+            void reserve(uint32_t count) const
+            {
+                if (available() < count)
+                {
+                    throw_result(xlang_error_mem_invalid_size);
+                }
+            }
+
+            char_type* current() const noexcept
+            {
+                return buffer + written;
+            }
+        };
+
+        inline void write_utf8(output_cursor<xlang_char8>& out, char32_t c)
+        {
+            uint32_t const count = utf8_length(c);
+            out.reserve(count);
+            if (out.buffer)
+            {
+                auto dest = reinterpret_cast<uint8_t*>(out.current());
+                switch (count)
+                {
+                case 1:
+                    dest[0] = static_cast<uint8_t>(c);
+                    break;
+                case 2:
+                    dest[0] = static_cast<uint8_t>(0xC0 | (c >> 6));
+                    dest[1] = static_cast<uint8_t>(0x80 | (c & 0x3F));
+                    break;
+                case 3:
+                    dest[0] = static_cast<uint8_t>(0xE0 | (c >> 12));
+                    dest[1] = static_cast<uint8_t>(0x80 | ((c >> 6) & 0x3F));
+                    dest[2] = static_cast<uint8_t>(0x80 | (c & 0x3F));
+                    break;
+                default:
+                    dest[0] = static_cast<uint8_t>(0xF0 | (c >> 18));
+                    dest[1] = static_cast<uint8_t>(0x80 | ((c >> 12) & 0x3F));
+                    dest[2] = static_cast<uint8_t>(0x80 | ((c >> 6) & 0x3F));
+                    dest[3] = static_cast<uint8_t>(0x80 | (c & 0x3F));
+                    break;
+                }
+            }
+            out.written += count;
+        }
+
+        inline void write_utf16(output_cursor<char16_t>& out, char32_t c)
+        {
+            uint32_t const count = utf16_length(c);
+            out.reserve(count);
+            if (out.buffer)
+            {
+                char16_t* dest = out.current();
+                if (count == 1)
+                {
+                    dest[0] = static_cast<char16_t>(c);
+                }
+                else
+                {
+                    c -= 0x10000;
+                    dest[0] = static_cast<char16_t>(0xD800 + (c >> 10));
+                    dest[1] = static_cast<char16_t>(0xDC00 + (c & 0x3FF));
+                }
+            }
+            out.written += count;
+        }
+    }
+
     uint32_t get_converted_length(std::basic_string_view<char16_t> input_str)
     {
         return convert_string(input_str, nullptr, 0);
@@ -19,19 +253,94 @@ namespace xlang::impl
         uint32_t buffer_size)
     {
         static_assert(sizeof(xlang_char8) == sizeof(char));
- 
-        // TODO: implement convert_string for non-windows platforms (#47)
-        throw_result(xlang_error_sadness);
+        simd_kernels const& kernels = get_simd_kernels();
+
+        char16_t const* first = input_str.data();
+        char16_t const* const last = first + input_str.size();
+        output_cursor<xlang_char8> out{ output_buffer, buffer_size };
+
+        while (first != last)
+        {
+            size_t const remaining = static_cast<size_t>(last - first);
+            if (output_buffer)
+            {
+                size_t const converted = kernels.narrow_ascii(first, std::min<size_t>(remaining, out.available()), out.current());
+                first += converted;
+                out.written += static_cast<uint32_t>(converted);
+
+                size_t written{};
+                first += kernels.narrow_utf16(first, static_cast<size_t>(last - first), out.current(), out.available(), written);
+                out.written += static_cast<uint32_t>(written);
+            }
+            else
+            {
+                size_t measured{};
+                size_t const consumed = kernels.measure_utf16(first, remaining, measured);
+                if (measured > out.available())
+                {
+                    throw_result(xlang_error_mem_invalid_size);
+                }
+                first += consumed;
+                out.written += static_cast<uint32_t>(measured);
+            }
+
+            // Convert what the kernels stopped in front of one code point at a time: surrogate pairs (or an
+            // error), and runs too close to the end for a vector block. Then go back to the vector paths.
+            while (first != last && !is_ascii(*first))
+            {
+                write_utf8(out, decode_utf16(first, last));
+                if (first != last && !is_surrogate(*first) && last - first >= scalar_tail)
+                {
+                    break;
+                }
+            }
+            if (first != last && is_ascii(*first))
+            {
+                write_utf8(out, *first++);
+            }
+        }
+        return out.written;
     }
-    
+
     uint32_t convert_string(
         std::basic_string_view<xlang_char8> input_str,
         char16_t* output_buffer,
         uint32_t buffer_size)
     {
         static_assert(sizeof(xlang_char8) == sizeof(char));
+        simd_kernels const& kernels = get_simd_kernels();
+
+        uint8_t const* first = reinterpret_cast<uint8_t const*>(input_str.data());
+        uint8_t const* const last = first + input_str.size();
+        output_cursor<char16_t> out{ output_buffer, buffer_size };
+
+        while (first != last)
+        {
+            size_t const remaining = static_cast<size_t>(last - first);
+            size_t const converted = output_buffer ?
+                kernels.widen_ascii(first, std::min<size_t>(remaining, out.available()), out.current()) :
+                kernels.count_ascii(first, std::min<size_t>(remaining, out.available()));
+            first += converted;
+            out.written += static_cast<uint32_t>(converted);
+
+            size_t written{};
+            first += kernels.widen_utf8(first, std::min<size_t>(static_cast<size_t>(last - first), out.available()), output_buffer ? out.current() : nullptr, written);
+            out.written += static_cast<uint32_t>(written);
 
-        // TODO: implement convert_string for non-windows platforms (#47)
-        throw_result(xlang_error_sadness);
+            // As above, for three and four byte sequences (or an error).
+            while (first != last && !is_ascii(*first))
+            {
+                write_utf16(out, decode_utf8(first, last));
+                if (first != last && *first < 0xE0 && last - first >= scalar_tail)
+                {
+                    break;
+                }
+            }
+            if (first != last && is_ascii(*first))
+            {
+                write_utf16(out, *first++);
+            }
+        }
+        return out.written;
     }
-}
\ No newline at end of file
+}
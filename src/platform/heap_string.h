@@ -4,6 +4,9 @@
 #include "atomic_ref_count.h"
 #include "heap_string.h"
 #include "cache_string.h"
+#include "string_allocator.h"
+#include "intern_table.h"
+#include "string_arena.h"
 
 namespace xlang::impl
 {
@@ -14,6 +17,14 @@ namespace xlang::impl
         int32_t addref() noexcept;
         int32_t release() noexcept;
 
+        // Like release, except that when the last reference goes the string's storage is left for the caller,
+        // which must give it back. Returns whether it was the last. For arena members released in batches.
+        bool release_keeping_storage() noexcept;
+
+        // For the intern table, which can find strings whose last reference is being released concurrently.
+        bool try_addref() noexcept;
+        void mark_interned() noexcept;
+
         template <typename char_type>
         static heap_string* create(
             char_type const* source_string,
@@ -25,12 +36,31 @@ namespace xlang::impl
             uint32_t length,
             cache_string* alternate);
 
+        // Converts up front, allocating the alternate in the same block as the string, so it never has to be
+        // created and attached later.
+        template <typename char_type>
+        static heap_string* create_dual(
+            char_type const* source_string,
+            uint32_t length);
+
+        // Constructs the string in storage that is part of an arena block shared with other strings. Storage
+        // must hold packed_buffer_size<heap_string, char_type>(length) bytes.
+        template <typename char_type>
+        static heap_string* create_arena_member(
+            void* storage,
+            char_type const* source_string,
+            uint32_t length) noexcept;
+
         template <typename char_type>
         static heap_string* create_preallocated(uint32_t length);
 
         heap_string* promote_preallocated(uint32_t length);
         void free_preallocated();
 
+        // Zero until xlang_hash_string first computes the hash, which is then kept for the string's lifetime.
+        uint32_t get_cached_hash() const noexcept;
+        void set_cached_hash(uint32_t value) const noexcept;
+
         // Read the ptr, but don't create it. May be null.
         cache_string const* get_alternate() const noexcept;
         cache_string* get_alternate() noexcept;
@@ -56,6 +86,8 @@ namespace xlang::impl
         heap_string(heap_string const&) = delete;
         heap_string& operator=(heap_string const&) = delete;
 
+        void destroy() noexcept;
+
         template <typename char_type>
         static heap_string* create_impl(
             char_type const* source_string,
@@ -63,9 +95,14 @@ namespace xlang::impl
             cache_string* alternate);
 
         atomic_ref_count count;
+
+        // Occupies what would otherwise be tail padding on 64-bit platforms, so heap strings don't get larger.
+        mutable std::atomic<uint32_t> hash{};
         inline static std::atomic<uint32_t> total_string_count{ 0 };
     };
 
+    static_assert(sizeof(void*) != 8 || sizeof(heap_string) == sizeof(string_base) + 8, "The cached hash should fit in the header's padding");
+
     template <typename char_type>
     heap_string* heap_string::create(
         char_type const* source_string,
@@ -91,6 +128,50 @@ namespace xlang::impl
         return create_impl(source_string, length, alternate);
     }
 
+    template <typename char_type>
+    heap_string* heap_string::create_dual(
+        char_type const* source_string,
+        uint32_t length)
+    {
+        if (length == 0)
+        {
+            return nullptr;
+        }
+
+        // [heap_string][characters][padding][cache_string][converted characters]
+        uint32_t const alternate_length = get_converted_length({ source_string, length });
+        uint32_t const string_size = packed_buffer_size<heap_string, char_type>(length);
+        uint32_t const alternate_size = cache_string::packed_size<char_type>(alternate_length);
+        constexpr uint32_t alignment_padding = alignof(cache_string) - 1;
+        if (std::numeric_limits<uint32_t>::max() - alignment_padding - alternate_size < string_size)
+        {
+            throw_result(xlang_error_mem_invalid_size);
+        }
+        uint32_t const alternate_offset = (string_size + alignment_padding) & ~alignment_padding;
+
+        std::unique_ptr<void, string_storage_deleter> storage{ allocate_string_storage(alternate_offset + alternate_size, storage_kind::heap_string) };
+        cache_string* alternate = cache_string::create_at(static_cast<uint8_t*>(storage.get()) + alternate_offset, source_string, length, alternate_length);
+
+        heap_string* new_string = static_cast<heap_string*>(storage.release());
+        new (new_string) heap_string(source_string, length, get_packed_buffer_ptr<heap_string, char_type>(new_string));
+        new_string->set_alternate_ptr<cache_string>(alternate);
+        new_string->set_embedded_alternate_flag();
+        return new_string;
+    }
+
+    template <typename char_type>
+    heap_string* heap_string::create_arena_member(
+        void* storage,
+        char_type const* source_string,
+        uint32_t length) noexcept
+    {
+        XLANG_ASSERT(source_string && length != 0);
+        heap_string* new_string = static_cast<heap_string*>(storage);
+        new (new_string) heap_string(source_string, length, get_packed_buffer_ptr<heap_string, char_type>(new_string));
+        new_string->set_arena_member_flag();
+        return new_string;
+    }
+
     template <typename char_type>
     heap_string* heap_string::create_preallocated(uint32_t length)
     {
@@ -116,6 +197,17 @@ namespace xlang::impl
         return const_cast<char_type*>(this->get_buffer<char_type>());
     }
 
+    inline uint32_t heap_string::get_cached_hash() const noexcept
+    {
+        return hash.load(std::memory_order_relaxed);
+    }
+
+    inline void heap_string::set_cached_hash(uint32_t value) const noexcept
+    {
+        // Every thread computes the same value, so racing stores are harmless.
+        hash.store(value, std::memory_order_relaxed);
+    }
+
     inline int32_t heap_string::get_ref_count() const noexcept
     {
         return count.get_count();
@@ -211,33 +303,66 @@ namespace xlang::impl
         return ++count;
     }
 
+    inline bool heap_string::try_addref() noexcept
+    {
+        return count.try_increment();
+    }
+
+    inline void heap_string::mark_interned() noexcept
+    {
+        // Only before the string is published, so flags don't need synchronization.
+        set_interned_flag();
+    }
+
     inline int32_t heap_string::release() noexcept
     {
         auto const result = --count;
         if (result == 0)
         {
-            auto alternate = get_alternate();
-            if (alternate)
+            destroy();
+            if (is_arena_member())
             {
-                alternate->release();
+                release_arena_member(this);
+            }
+            else
+            {
+                free_string_storage(this);
             }
-
-            xlang_mem_free(this);
         }
         return result;
     }
 
+    inline bool heap_string::release_keeping_storage() noexcept
+    {
+        if (--count != 0)
+        {
+            return false;
+        }
+        destroy();
+        return true;
+    }
+
+    inline void heap_string::destroy() noexcept
+    {
+        if (is_interned())
+        {
+            remove_interned_string(this);
+        }
+
+        auto alternate = get_alternate();
+        if (alternate && !has_embedded_alternate())
+        {
+            alternate->release();
+        }
+    }
+
     template <typename char_type>
     inline heap_string* heap_string::create_impl(
         char_type const* source_string,
         uint32_t length,
         cache_string* alternate)
     {
-        heap_string* new_string = reinterpret_cast<heap_string*>(xlang_mem_alloc(packed_buffer_size<heap_string, char_type>(length)));
-        if (!new_string)
-        {
-            throw std::bad_alloc{};
-        }
+        heap_string* new_string = reinterpret_cast<heap_string*>(allocate_string_storage(packed_buffer_size<heap_string, char_type>(length), storage_kind::heap_string));
 
         char_type* buffer = get_packed_buffer_ptr<heap_string, char_type>(new_string);
         new (new_string) heap_string(source_string, length, buffer);
@@ -0,0 +1,126 @@
+#include "intern_table.h"
+#include "heap_string.h"
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+namespace xlang::impl
+{
+    namespace
+    {
+        // String contents viewed as bytes, with the hash computed once up front so it can pick both the shard
+        // and the bucket.
+        struct intern_key
+        {
+            std::string_view bytes;
+            size_t hash;
+            bool is_utf8;
+
+            bool operator==(intern_key const& other) const noexcept
+            {
+                return is_utf8 == other.is_utf8 && bytes == other.bytes;
+            }
+        };
+
+        struct intern_key_hash
+        {
+            size_t operator()(intern_key const& key) const noexcept
+            {
+                return key.hash;
+            }
+        };
+
+        template <typename char_type>
+        intern_key make_key(char_type const* buffer, uint32_t length) noexcept
+        {
+            constexpr bool is_utf8 = std::is_same_v<char_type, xlang_char8>;
+            std::string_view const bytes{ reinterpret_cast<char const*>(buffer), length * sizeof(char_type) };
+            return { bytes, std::hash<std::string_view>{}(bytes) ^ is_utf8, is_utf8 };
+        }
+
+        intern_key make_key(heap_string const& str) noexcept
+        {
+            return str.is_utf8() ?
+                make_key(str.get_buffer<xlang_char8>(), str.get_length()) :
+                make_key(str.get_buffer<char16_t>(), str.get_length());
+        }
+
+        // Keys view into the characters of the heap_string they map to, so an entry never outlives its string.
+        struct alignas(64) shard
+        {
+            std::mutex mutex;
+            std::unordered_map<intern_key, heap_string*, intern_key_hash> strings;
+        };
+
+        constexpr size_t shard_count = 64;
+
+        shard& get_shard(size_t hash) noexcept
+        {
+            // Intentionally leaked, so interned strings released during static destruction can still unregister.
+            static shard* shards = new shard[shard_count];
+
+            // The low bits pick the bucket within a shard; use different ones here.
+            return shards[(hash >> 20) % shard_count];
+        }
+
+        template <typename char_type>
+        heap_string* create_interned(char_type const* source_string, uint32_t length)
+        {
+            XLANG_ASSERT(length != 0);
+            auto const key = make_key(source_string, length);
+            shard& target = get_shard(key.hash);
+
+            std::lock_guard lock{ target.mutex };
+            auto it = target.strings.find(key);
+            if (it != target.strings.end())
+            {
+                if (it->second->try_addref())
+                {
+                    return it->second;
+                }
+
+                // Its last reference is being released on another thread, which will unregister it once it gets
+                // the lock. It only removes the entry if it still maps to that string, so replace it here.
+                target.strings.erase(it);
+            }
+
+            heap_string* str = heap_string::create(source_string, length);
+            try
+            {
+                target.strings.emplace(make_key(*str), str);
+            }
+            catch (...)
+            {
+                // Not marked yet, so this doesn't come back to the table for the lock we already hold.
+                str->release();
+                throw;
+            }
+            str->mark_interned();
+            return str;
+        }
+    }
+
+    heap_string* create_interned_string(xlang_char8 const* source_string, uint32_t length)
+    {
+        return create_interned(source_string, length);
+    }
+
+    heap_string* create_interned_string(char16_t const* source_string, uint32_t length)
+    {
+        return create_interned(source_string, length);
+    }
+
+    void remove_interned_string(heap_string* str) noexcept
+    {
+        auto const key = make_key(*str);
+        shard& target = get_shard(key.hash);
+
+        std::lock_guard lock{ target.mutex };
+        auto it = target.strings.find(key);
+        if (it != target.strings.end() && it->second == str)
+        {
+            target.strings.erase(it);
+        }
+    }
+}
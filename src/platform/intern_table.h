@@ -0,0 +1,17 @@
+#pragma once
+
+#include "pal_internal.h"
+
+namespace xlang::impl
+{
+    struct heap_string;
+
+    // Returns a new reference to the live heap_string with the given contents, creating and registering one if
+    // there is none. Strings are interned per encoding: equal text created as UTF-8 and as UTF-16 yields two
+    // strings. Length must be nonzero.
+    heap_string* create_interned_string(xlang_char8 const* source_string, uint32_t length);
+    heap_string* create_interned_string(char16_t const* source_string, uint32_t length);
+
+    // Called by an interned string whose last reference has been released, before it is freed.
+    void remove_interned_string(heap_string* str) noexcept;
+}
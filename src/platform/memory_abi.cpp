@@ -0,0 +1,162 @@
+#include "pal_internal.h"
+#include "platform_memory.h"
+#include "string_allocator.h"
+#include <atomic>
+#include <stdint.h>
+
+namespace xlang::impl
+{
+    namespace
+    {
+        // Null until the first allocation or xlang_set_allocator call, whichever comes first, decides it for good.
+        std::atomic<xlang_allocator const*> current_allocator{};
+
+        xlang_allocator const& get_allocator() noexcept
+        {
+            xlang_allocator const* allocator = current_allocator.load(std::memory_order_acquire);
+            if (!allocator)
+            {
+                allocator = &get_platform_allocator();
+                xlang_allocator const* expected{};
+                if (!current_allocator.compare_exchange_strong(expected, allocator, std::memory_order_acq_rel))
+                {
+                    allocator = expected;
+                }
+            }
+            return *allocator;
+        }
+
+        // Without aligned_alloc, the block is over-allocated and the pointer alloc returned is stored just
+        // ahead of the aligned address.
+        size_t aligned_fallback_size(size_t count, size_t alignment) noexcept
+        {
+            size_t const padding = alignment - 1 + sizeof(void*);
+            return count > SIZE_MAX - padding ? SIZE_MAX : count + padding;
+        }
+    }
+
+    void* allocate_memory(size_t count) noexcept
+    {
+        auto const& allocator = get_allocator();
+        return allocator.alloc(allocator.context, count == 0 ? 1 : count);
+    }
+
+    void free_memory(void* ptr, size_t count) noexcept
+    {
+        if (!ptr)
+        {
+            return;
+        }
+
+        auto const& allocator = get_allocator();
+        if (allocator.sized_free)
+        {
+            allocator.sized_free(allocator.context, ptr, count == 0 ? 1 : count);
+        }
+        else
+        {
+            allocator.free(allocator.context, ptr);
+        }
+    }
+
+    void* allocate_aligned_memory(size_t count, size_t alignment) noexcept
+    {
+        XLANG_ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+        auto const& allocator = get_allocator();
+        if (allocator.aligned_alloc)
+        {
+            return allocator.aligned_alloc(allocator.context, count == 0 ? 1 : count, alignment);
+        }
+
+        void* const original = allocator.alloc(allocator.context, aligned_fallback_size(count, alignment));
+        if (!original)
+        {
+            return nullptr;
+        }
+
+        uintptr_t const aligned = (reinterpret_cast<uintptr_t>(original) + sizeof(void*) + alignment - 1) & ~(uintptr_t{ alignment } - 1);
+        reinterpret_cast<void**>(aligned)[-1] = original;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    void free_aligned_memory(void* ptr, size_t count, size_t alignment) noexcept
+    {
+        if (!ptr)
+        {
+            return;
+        }
+
+        auto const& allocator = get_allocator();
+        if (allocator.aligned_alloc)
+        {
+            allocator.aligned_free(allocator.context, ptr);
+        }
+        else
+        {
+            free_memory(static_cast<void**>(ptr)[-1], aligned_fallback_size(count, alignment));
+        }
+    }
+}
+
+using namespace xlang::impl;
+
+extern "C"
+{
+    void* XLANG_CALL xlang_mem_alloc(size_t count) XLANG_NOEXCEPT
+    {
+        return allocate_memory(count);
+    }
+
+    void XLANG_CALL xlang_mem_free(void* ptr) XLANG_NOEXCEPT
+    {
+        if (ptr)
+        {
+            auto const& allocator = get_allocator();
+            allocator.free(allocator.context, ptr);
+        }
+    }
+}
+
+XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_set_allocator(
+    xlang_allocator const* allocator
+) XLANG_NOEXCEPT
+try
+{
+    if (!allocator)
+    {
+        xlang::throw_result(xlang_error_pointer);
+    }
+    if (!allocator->alloc || !allocator->free || (!allocator->aligned_alloc != !allocator->aligned_free))
+    {
+        xlang::throw_result(xlang_error_invalid_arg);
+    }
+
+    xlang_allocator const* expected{};
+    if (!current_allocator.compare_exchange_strong(expected, allocator, std::memory_order_acq_rel))
+    {
+        xlang::throw_result(xlang_error_illegal_state_change);
+    }
+    return xlang_error_ok;
+}
+catch (...)
+{
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_get_diagnostics(
+    xlang_diagnostics* diagnostics
+) XLANG_NOEXCEPT
+try
+{
+    if (!diagnostics)
+    {
+        xlang::throw_result(xlang_error_pointer);
+    }
+    get_string_storage_diagnostics(*diagnostics);
+    return xlang_error_ok;
+}
+catch (...)
+{
+    return xlang::to_result();
+}
@@ -1,5 +1,6 @@
 #include "pal_internal.h"
 #include "heap_string.h"
+#include "string_builder.h"
 
 namespace xlang::impl
 {
@@ -25,6 +26,16 @@ namespace xlang::impl
         return reinterpret_cast<xlang_string_buffer>(str);
     }
 
+    inline string_builder* from_handle(xlang_string_builder handle) noexcept
+    {
+        return reinterpret_cast<string_builder*>(handle);
+    }
+
+    inline xlang_string_builder to_builder_handle(string_builder* builder) noexcept
+    {
+        return reinterpret_cast<xlang_string_builder>(builder);
+    }
+
     template <typename char_type>
     inline std::basic_string_view<char_type> to_string_view(xlang_string handle)
     {
@@ -19,6 +19,10 @@ namespace xlang::impl
     xlang_pfn_lib_get_activation_factory try_get_activation_func(
         std::basic_string_view<char16_t> module_namespace);
 
+#if !XLANG_PLATFORM_WINDOWS
+    void set_activation_search_path(char const* search_path);
+#endif
+
     template <typename char_type>
     inline constexpr std::basic_string_view<char_type> enclosing_namespace(std::basic_string_view<char_type> str) noexcept
     {
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "pal.h"
+
+namespace xlang::impl
+{
+    // The allocator xlang_mem_alloc uses unless the host installs its own: malloc on most platforms,
+    // CoTaskMemAlloc on Windows.
+    xlang_allocator const& get_platform_allocator() noexcept;
+
+    // Allocations the PAL makes for itself, through whichever allocator is in effect. Unlike xlang_mem_free,
+    // these pass the allocation size back, so a host allocator that supplies sized_free can use it.
+    void* allocate_memory(size_t count) noexcept;
+    void free_memory(void* ptr, size_t count) noexcept;
+
+    // Alignment must be a power of two. Falls back to over-allocating through alloc when the allocator has
+    // no aligned_alloc. Memory from allocate_aligned_memory must only be released with free_aligned_memory.
+    void* allocate_aligned_memory(size_t count, size_t alignment) noexcept;
+    void free_aligned_memory(void* ptr, size_t count, size_t alignment) noexcept;
+}
@@ -92,12 +92,50 @@ extern "C"
     };
     typedef xlang_string_buffer__* xlang_string_buffer;
 
+    struct xlang_string_builder__
+    {
+        int unused;
+    };
+    typedef xlang_string_builder__* xlang_string_builder;
+
     struct xlang_string_header
     {
         void* reserved1;
         char reserved2[16];
     };
 
+    // One element of the array passed to xlang_create_strings_utf8/utf16
+    struct xlang_string_source_utf8
+    {
+        xlang_char8 const* source_string;
+        uint32_t length;
+    };
+
+    struct xlang_string_source_utf16
+    {
+        char16_t const* source_string;
+        uint32_t length;
+    };
+
+    // Published layout of the header every non-null xlang_string points to, so that the inline accessors below
+    // can read a string's native encoding without calling into the PAL. XLANG_STRING_LAYOUT_VERSION changes
+    // whenever the layout or the meaning of XLANG_STRING_LAYOUT_UTF8 does; compare it with
+    // xlang_get_string_layout_version before relying on the layout. All other flag bits are private to the PAL.
+#define XLANG_STRING_LAYOUT_VERSION 1
+#define XLANG_STRING_LAYOUT_UTF8 0x20
+
+    struct xlang_string_layout
+    {
+        uint32_t flags;
+        uint32_t length;
+        union
+        {
+            void* alternate; // Written once, atomically, by the PAL; null until the other encoding is requested
+            uint32_t reserved[2];
+        };
+        void const* buffer;  // Native characters, null-terminated
+    };
+
     struct xlang_guid
     {
         uint32_t Data1;
@@ -157,11 +195,58 @@ extern "C"
     };
 #endif
 
+    // Memory functions a host can supply in place of the platform allocator. Each receives the context pointer
+    // given alongside it. The sized and aligned functions are optional; aligned_alloc and aligned_free must be
+    // supplied together. None of them may throw.
+    struct xlang_allocator
+    {
+        void* context;
+        void* (XLANG_CALL * alloc)(void* context, size_t count);
+        void (XLANG_CALL * free)(void* context, void* ptr);
+        void (XLANG_CALL * sized_free)(void* context, void* ptr, size_t count);
+        void* (XLANG_CALL * aligned_alloc)(void* context, size_t count, size_t alignment);
+        void (XLANG_CALL * aligned_free)(void* context, void* ptr);
+    };
+
+    // Snapshot of the memory the PAL holds for strings. Live counts and bytes are by kind: heap strings
+    // (including string buffers and the alternates of dual strings), and the alternate encodings created on
+    // demand for string references and static strings, or for heap strings. Bytes include allocation overhead.
+    // Totals run from when the PAL was loaded. The high-water mark is the most bytes live at once, give or
+    // take 64 KiB for each thread that has been allocating.
+    struct xlang_diagnostics
+    {
+        uint64_t live_heap_strings;
+        uint64_t live_reference_alternates;
+        uint64_t live_cache_alternates;
+        uint64_t heap_string_bytes;
+        uint64_t reference_alternate_bytes;
+        uint64_t cache_alternate_bytes;
+        uint64_t allocation_count;
+        uint64_t free_count;
+        uint64_t allocated_bytes;
+        uint64_t freed_bytes;
+        uint64_t high_water_bytes;
+    };
+
     // Function declarations
     XLANG_PAL_EXPORT void* XLANG_CALL xlang_mem_alloc(size_t count) XLANG_NOEXCEPT;
 
     XLANG_PAL_EXPORT void XLANG_CALL xlang_mem_free(void* ptr) XLANG_NOEXCEPT;
 
+    // Installs the allocator behind xlang_mem_alloc/xlang_mem_free and the PAL's string storage: heap strings,
+    // their cached alternates and string arenas, including a string builder's buffer. The PAL's other bookkeeping
+    // (activation caches and registrations, the intern table, string builder objects) still uses the C++ runtime's
+    // allocator. The allocator must remain valid for the life of the process. Only possible before the PAL
+    // allocates anything.
+    XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_set_allocator(
+        xlang_allocator const* allocator
+    ) XLANG_NOEXCEPT;
+
+    // Counting is always on; each thread keeps its own counters, which this sums.
+    XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_get_diagnostics(
+        xlang_diagnostics* diagnostics
+    ) XLANG_NOEXCEPT;
+
     XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_create_string_utf8(
         xlang_char8 const* source_string,
         uint32_t length,
@@ -186,8 +271,68 @@ extern "C"
         xlang_string* string
     ) XLANG_NOEXCEPT;
 
+    // Creates a string that holds both encodings from the start, converted once and allocated together, for
+    // strings that will be read as both UTF-8 and UTF-16.
+    XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_create_string_dual_utf8(
+        xlang_char8 const* source_string,
+        uint32_t length,
+        xlang_string* string
+    ) XLANG_NOEXCEPT;
+    XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_create_string_dual_utf16(
+        char16_t const* source_string,
+        uint32_t length,
+        xlang_string* string
+    ) XLANG_NOEXCEPT;
+
+    // Returns the live string with these contents, if there is one, otherwise creates it. While any reference to
+    // an interned string remains, interning equal contents in the same encoding yields the same handle.
+    XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_create_string_interned_utf8(
+        xlang_char8 const* source_string,
+        uint32_t length,
+        xlang_string* string
+    ) XLANG_NOEXCEPT;
+    XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_create_string_interned_utf16(
+        char16_t const* source_string,
+        uint32_t length,
+        xlang_string* string
+    ) XLANG_NOEXCEPT;
+
+    // Like a string reference, but the header and characters must stay valid for the life of the process. The
+    // resulting string is immortal: duplicating it returns the same handle and deleting it does nothing.
+    XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_create_string_static_utf8(
+        xlang_char8 const* source_string,
+        uint32_t length,
+        xlang_string_header* header,
+        xlang_string* string
+    ) XLANG_NOEXCEPT;
+    XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_create_string_static_utf16(
+        char16_t const* source_string,
+        uint32_t length,
+        xlang_string_header* header,
+        xlang_string* string
+    ) XLANG_NOEXCEPT;
+
     XLANG_PAL_EXPORT void XLANG_CALL xlang_delete_string(xlang_string string) XLANG_NOEXCEPT;
 
+    // Creates or deletes count strings in one call, for marshaling arrays. Small strings created together share
+    // allocations, which are freed once every string in them has been deleted, individually or in a batch. On
+    // failure no strings are created and every element of strings is null.
+    XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_create_strings_utf8(
+        xlang_string_source_utf8 const* sources,
+        uint32_t count,
+        xlang_string* strings
+    ) XLANG_NOEXCEPT;
+    XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_create_strings_utf16(
+        xlang_string_source_utf16 const* sources,
+        uint32_t count,
+        xlang_string* strings
+    ) XLANG_NOEXCEPT;
+
+    XLANG_PAL_EXPORT void XLANG_CALL xlang_delete_strings(
+        xlang_string const* strings,
+        uint32_t count
+    ) XLANG_NOEXCEPT;
+
     XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_delete_string_buffer(xlang_string_buffer buffer_handle) XLANG_NOEXCEPT;
 
     XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_duplicate_string(
@@ -199,6 +344,8 @@ extern "C"
         xlang_string string
     ) XLANG_NOEXCEPT;
 
+    XLANG_PAL_EXPORT uint32_t XLANG_CALL xlang_get_string_layout_version() XLANG_NOEXCEPT;
+
     XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_get_string_raw_buffer_utf8(
         xlang_string string,
         xlang_char8 const* * buffer,
@@ -210,6 +357,23 @@ extern "C"
         uint32_t* length
     ) XLANG_NOEXCEPT;
 
+    // Copies the string, null-terminated, into a caller-provided buffer of buffer_length code units, converting
+    // it if necessary without attaching an alternate. required_length receives the string's length in the
+    // suffix's encoding, not counting the terminator, even when the buffer is too small. A null buffer only
+    // measures.
+    XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_copy_string_to_buffer_utf8(
+        xlang_string string,
+        xlang_char8* buffer,
+        uint32_t buffer_length,
+        uint32_t* required_length
+    ) XLANG_NOEXCEPT;
+    XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_copy_string_to_buffer_utf16(
+        xlang_string string,
+        char16_t* buffer,
+        uint32_t buffer_length,
+        uint32_t* required_length
+    ) XLANG_NOEXCEPT;
+
     XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_preallocate_string_buffer_utf8(
         uint32_t length,
         xlang_char8** char_buffer,
@@ -227,6 +391,67 @@ extern "C"
         uint32_t length
     ) XLANG_NOEXCEPT;
 
+    // Encoding-independent: equal text hashes equally in UTF-8 and UTF-16. Not stable across PAL versions.
+    XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_hash_string(
+        xlang_string string,
+        uint32_t* hash
+    ) XLANG_NOEXCEPT;
+
+    // Orders by Unicode code point, whatever the strings' encodings. result is negative, zero or positive.
+    XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_compare_string_ordinal(
+        xlang_string left,
+        xlang_string right,
+        int32_t* result
+    ) XLANG_NOEXCEPT;
+
+    // Concatenates count strings into a new string in the suffix's encoding, converting inputs in the other
+    // encoding directly into the result.
+    XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_concat_strings_utf8(
+        xlang_string const* strings,
+        uint32_t count,
+        xlang_string* string
+    ) XLANG_NOEXCEPT;
+    XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_concat_strings_utf16(
+        xlang_string const* strings,
+        uint32_t count,
+        xlang_string* string
+    ) XLANG_NOEXCEPT;
+
+    // A growable buffer in the suffix's encoding, which becomes a string without being copied when promoted.
+    XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_create_string_builder_utf8(
+        uint32_t capacity,
+        xlang_string_builder* builder
+    ) XLANG_NOEXCEPT;
+    XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_create_string_builder_utf16(
+        uint32_t capacity,
+        xlang_string_builder* builder
+    ) XLANG_NOEXCEPT;
+
+    XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_string_builder_append_utf8(
+        xlang_string_builder builder,
+        xlang_char8 const* source_string,
+        uint32_t length
+    ) XLANG_NOEXCEPT;
+    XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_string_builder_append_utf16(
+        xlang_string_builder builder,
+        char16_t const* source_string,
+        uint32_t length
+    ) XLANG_NOEXCEPT;
+    XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_string_builder_append_string(
+        xlang_string_builder builder,
+        xlang_string string
+    ) XLANG_NOEXCEPT;
+
+    // On success the builder is consumed, and must not be used or deleted afterwards.
+    XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_promote_string_builder(
+        xlang_string_builder builder,
+        xlang_string* string
+    ) XLANG_NOEXCEPT;
+
+    XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_delete_string_builder(
+        xlang_string_builder builder
+    ) XLANG_NOEXCEPT;
+
     XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_get_activation_factory(
         xlang_string class_name,
         xlang_guid const& iid,
@@ -235,6 +460,41 @@ extern "C"
 
     typedef xlang_result(XLANG_CALL * xlang_pfn_lib_get_activation_factory)(xlang_string, xlang_guid const&, void **);
 
+    // Registers an activation function for classes under class_name_prefix, a namespace or a full class name, in
+    // UTF-8. Registered functions are tried before any library is probed, from the class name outwards, so
+    // statically linked components are activated without touching the filesystem. Registrations last for the
+    // life of the process, and may be made during static initialization; see
+    // xlang_activation_factory_registration.
+    XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_register_activation_factory(
+        char const* class_name_prefix,
+        xlang_pfn_lib_get_activation_factory pfn
+    ) XLANG_NOEXCEPT;
+
+    struct xlang_activation_factory_cache_stats
+    {
+        uint64_t hits;
+        uint64_t misses;
+        uint32_t entries;
+    };
+
+    // Releases cached factories for classes in the given namespace, or all of them if class_name_prefix is null.
+    // Call before unloading a component library, while none of its classes are being activated.
+    XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_invalidate_activation_factory_cache(
+        xlang_string class_name_prefix
+    ) XLANG_NOEXCEPT;
+
+    XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_get_activation_factory_cache_stats(
+        xlang_activation_factory_cache_stats* stats
+    ) XLANG_NOEXCEPT;
+
+#if !XLANG_PLATFORM_WINDOWS
+    // Colon-separated directories searched for component libraries. Null restores the default, taken from
+    // the XLANG_ACTIVATION_PATH environment variable.
+    XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_set_activation_search_path(
+        char const* search_path
+    ) XLANG_NOEXCEPT;
+#endif
+
 
 #ifdef __cplusplus
 }
@@ -250,6 +510,93 @@ inline constexpr xlang_result xlang_error_out_of_memory{ 0x8007000e };
 inline constexpr xlang_result xlang_error_invalid_arg{ 0x80070057 };
 inline constexpr xlang_result xlang_error_untranslatable_string{ 0x80070459 };
 inline constexpr xlang_result xlang_error_class_not_available{ 0x80040111 };
+inline constexpr xlang_result xlang_error_illegal_state_change{ 0x8000000d };
+inline constexpr xlang_result xlang_error_insufficient_buffer{ 0x8007007a };
+
+// Inline equivalents of the string accessors, for callers built against the same XLANG_STRING_LAYOUT_VERSION as
+// the PAL they run with. They answer from the string header when the string is natively in the requested
+// encoding, and call the exported function only when it isn't.
+
+inline xlang_string_layout const* xlang_get_string_layout(xlang_string string) noexcept
+{
+    return reinterpret_cast<xlang_string_layout const*>(string);
+}
+
+inline xlang_string_encoding xlang_get_string_encoding_inline(xlang_string string) noexcept
+{
+    xlang_string_layout const* layout = xlang_get_string_layout(string);
+    if (!layout)
+    {
+        return xlang_string_encoding::utf8 | xlang_string_encoding::utf16;
+    }
+
+    // Only compared with null, so no ordering is needed.
+#if XLANG_COMPILER_MSVC
+    void* const alternate = *static_cast<void* const volatile*>(&layout->alternate);
+#else
+    void* const alternate = __atomic_load_n(&layout->alternate, __ATOMIC_RELAXED);
+#endif
+    if (alternate)
+    {
+        return xlang_string_encoding::utf8 | xlang_string_encoding::utf16;
+    }
+    return (layout->flags & XLANG_STRING_LAYOUT_UTF8) ? xlang_string_encoding::utf8 : xlang_string_encoding::utf16;
+}
+
+inline xlang_result xlang_get_string_raw_buffer_utf8_inline(
+    xlang_string string,
+    xlang_char8 const* * buffer,
+    uint32_t* length) noexcept
+{
+    xlang_string_layout const* layout = xlang_get_string_layout(string);
+    if (!layout)
+    {
+        *buffer = u8"";
+        *length = 0;
+        return xlang_error_ok;
+    }
+    if (layout->flags & XLANG_STRING_LAYOUT_UTF8)
+    {
+        *buffer = static_cast<xlang_char8 const*>(layout->buffer);
+        *length = layout->length;
+        return xlang_error_ok;
+    }
+    return xlang_get_string_raw_buffer_utf8(string, buffer, length);
+}
+
+inline xlang_result xlang_get_string_raw_buffer_utf16_inline(
+    xlang_string string,
+    char16_t const* * buffer,
+    uint32_t* length) noexcept
+{
+    xlang_string_layout const* layout = xlang_get_string_layout(string);
+    if (!layout)
+    {
+        *buffer = u"";
+        *length = 0;
+        return xlang_error_ok;
+    }
+    if (!(layout->flags & XLANG_STRING_LAYOUT_UTF8))
+    {
+        *buffer = static_cast<char16_t const*>(layout->buffer);
+        *length = layout->length;
+        return xlang_error_ok;
+    }
+    return xlang_get_string_raw_buffer_utf16(string, buffer, length);
+}
+
+// Registers a statically linked component's activation function while the program is being initialized. The cpp
+// tool's -component -register option emits one into module.g.cpp per namespace the component implements:
+//
+//     static xlang_activation_factory_registration const registration{ "Contoso.Widgets", &get_widgets_factory };
+struct xlang_activation_factory_registration
+{
+    xlang_activation_factory_registration(char const* class_name_prefix, xlang_pfn_lib_get_activation_factory pfn) noexcept
+        : result(xlang_register_activation_factory(class_name_prefix, pfn))
+    {}
+
+    xlang_result const result;
+};
 #endif
 
 #endif
\ No newline at end of file
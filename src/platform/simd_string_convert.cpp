@@ -0,0 +1,522 @@
+#include "simd_string_convert.h"
+#include <stdlib.h>
+#include <array>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define XLANG_PAL_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define XLANG_PAL_SIMD_X86 0
+#endif
+
+#ifdef _WIN32
+#error "This file is for targeting platforms other than Windows"
+#endif
+
+namespace xlang::impl
+{
+    namespace
+    {
+        // UTF-8 length contributed by one non-surrogate UTF-16 code unit
+        constexpr size_t bmp_utf8_length(char16_t c) noexcept
+        {
+            return c < 0x80 ? 1 : c < 0x800 ? 2 : 3;
+        }
+
+        constexpr bool is_surrogate(char16_t c) noexcept
+        {
+            return (c & 0xF800) == 0xD800;
+        }
+
+        size_t widen_ascii_scalar(uint8_t const* input, size_t length, char16_t* output) noexcept
+        {
+            size_t i = 0;
+            for (; i < length && input[i] < 0x80; ++i)
+            {
+                output[i] = input[i];
+            }
+            return i;
+        }
+
+        size_t narrow_ascii_scalar(char16_t const* input, size_t length, xlang_char8* output) noexcept
+        {
+            size_t i = 0;
+            for (; i < length && input[i] < 0x80; ++i)
+            {
+                output[i] = static_cast<xlang_char8>(input[i]);
+            }
+            return i;
+        }
+
+        size_t count_ascii_scalar(uint8_t const* input, size_t length) noexcept
+        {
+            size_t i = 0;
+            while (i < length && input[i] < 0x80)
+            {
+                ++i;
+            }
+            return i;
+        }
+
+        size_t measure_utf16_scalar(char16_t const* input, size_t length, size_t& utf8_length) noexcept
+        {
+            size_t i = 0;
+            for (; i < length && !is_surrogate(input[i]); ++i)
+            {
+                utf8_length += bmp_utf8_length(input[i]);
+            }
+            return i;
+        }
+
+        size_t count_equal_utf16_scalar(char16_t const* left, char16_t const* right, size_t length) noexcept
+        {
+            size_t i = 0;
+            while (i < length && left[i] == right[i])
+            {
+                ++i;
+            }
+            return i;
+        }
+
+        // The scalar transcoder decodes multi-byte sequences itself, so the scalar kernels leave them to it.
+
+        size_t widen_utf8_scalar(uint8_t const*, size_t, char16_t*, size_t&) noexcept
+        {
+            return 0;
+        }
+
+        size_t narrow_utf16_scalar(char16_t const*, size_t, xlang_char8*, size_t, size_t&) noexcept
+        {
+            return 0;
+        }
+
+#if XLANG_PAL_SIMD_X86
+
+        // Shuffle tables for the multi-byte kernels, built at compile time.
+
+        // How eight UTF-8 bytes made up of one and two byte sequences decode, indexed by which of them are
+        // continuation bytes. The shuffle moves each sequence into a 16-bit lane, with its lead byte in the high
+        // half, or zero there for ASCII.
+        struct utf8_block
+        {
+            uint8_t shuffle[16];
+            uint8_t units;
+        };
+
+        constexpr std::array<utf8_block, 256> make_utf8_blocks() noexcept
+        {
+            std::array<utf8_block, 256> result{};
+            for (uint32_t mask = 0; mask < 256; ++mask)
+            {
+                utf8_block& block = result[mask];
+                for (auto& index : block.shuffle)
+                {
+                    index = 0x80;
+                }
+
+                uint8_t units = 0;
+                for (uint32_t position = 0; position < 8; ++units)
+                {
+                    if (position < 7 && ((mask >> (position + 1)) & 1))
+                    {
+                        block.shuffle[2 * units] = static_cast<uint8_t>(position + 1);
+                        block.shuffle[2 * units + 1] = static_cast<uint8_t>(position);
+                        position += 2;
+                    }
+                    else
+                    {
+                        block.shuffle[2 * units] = static_cast<uint8_t>(position);
+                        position += 1;
+                    }
+                }
+                block.units = units;
+            }
+            return result;
+        }
+
+        constexpr std::array<utf8_block, 256> utf8_blocks = make_utf8_blocks();
+
+        // How four UTF-16 code units encode in UTF-8, indexed by which of them take one byte (low four bits) and
+        // which take at most two (high four bits). The shuffle packs the bytes each one needs out of its 32-bit
+        // lane, which holds its full encoding, lead byte first.
+        struct utf16_quad
+        {
+            uint8_t shuffle[16];
+            uint8_t length;
+        };
+
+        constexpr std::array<utf16_quad, 256> make_utf16_quads() noexcept
+        {
+            std::array<utf16_quad, 256> result{};
+            for (uint32_t key = 0; key < 256; ++key)
+            {
+                utf16_quad& quad = result[key];
+                for (auto& index : quad.shuffle)
+                {
+                    index = 0x80;
+                }
+
+                uint8_t length = 0;
+                for (uint32_t unit = 0; unit < 4; ++unit)
+                {
+                    uint32_t const bytes = ((key >> unit) & 1) ? 1 : ((key >> (unit + 4)) & 1) ? 2 : 3;
+                    for (uint32_t byte = 0; byte < bytes; ++byte)
+                    {
+                        quad.shuffle[length++] = static_cast<uint8_t>(4 * unit + byte);
+                    }
+                }
+                quad.length = length;
+            }
+            return result;
+        }
+
+        constexpr std::array<utf16_quad, 256> utf16_quads = make_utf16_quads();
+
+        // SSE4.2 kernels, working on 128-bit vectors.
+
+        __attribute__((target("sse4.2")))
+        size_t widen_ascii_sse42(uint8_t const* input, size_t length, char16_t* output) noexcept
+        {
+            size_t i = 0;
+            for (; i + 16 <= length; i += 16)
+            {
+                __m128i const bytes = _mm_loadu_si128(reinterpret_cast<__m128i const*>(input + i));
+                if (_mm_movemask_epi8(bytes))
+                {
+                    break;
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_cvtepu8_epi16(bytes));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i + 8), _mm_cvtepu8_epi16(_mm_srli_si128(bytes, 8)));
+            }
+            return i + widen_ascii_scalar(input + i, length - i, output + i);
+        }
+
+        __attribute__((target("sse4.2")))
+        size_t narrow_ascii_sse42(char16_t const* input, size_t length, xlang_char8* output) noexcept
+        {
+            __m128i const non_ascii = _mm_set1_epi16(static_cast<short>(0xFF80));
+            size_t i = 0;
+            for (; i + 16 <= length; i += 16)
+            {
+                __m128i const lo = _mm_loadu_si128(reinterpret_cast<__m128i const*>(input + i));
+                __m128i const hi = _mm_loadu_si128(reinterpret_cast<__m128i const*>(input + i + 8));
+                if (!_mm_testz_si128(_mm_or_si128(lo, hi), non_ascii))
+                {
+                    break;
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_packus_epi16(lo, hi));
+            }
+            return i + narrow_ascii_scalar(input + i, length - i, output + i);
+        }
+
+        __attribute__((target("sse4.2")))
+        size_t count_ascii_sse42(uint8_t const* input, size_t length) noexcept
+        {
+            size_t i = 0;
+            for (; i + 16 <= length; i += 16)
+            {
+                __m128i const bytes = _mm_loadu_si128(reinterpret_cast<__m128i const*>(input + i));
+                if (_mm_movemask_epi8(bytes))
+                {
+                    break;
+                }
+            }
+            return i + count_ascii_scalar(input + i, length - i);
+        }
+
+        __attribute__((target("sse4.2")))
+        size_t measure_utf16_sse42(char16_t const* input, size_t length, size_t& utf8_length) noexcept
+        {
+            __m128i const surrogate_mask = _mm_set1_epi16(static_cast<short>(0xF800));
+            __m128i const surrogate_bits = _mm_set1_epi16(static_cast<short>(0xD800));
+            __m128i const two_byte_mask = _mm_set1_epi16(static_cast<short>(0xFF80));
+            __m128i const three_byte_mask = _mm_set1_epi16(static_cast<short>(0xF800));
+            __m128i const zero = _mm_setzero_si128();
+
+            size_t i = 0;
+            for (; i + 8 <= length; i += 8)
+            {
+                __m128i const units = _mm_loadu_si128(reinterpret_cast<__m128i const*>(input + i));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(units, surrogate_mask), surrogate_bits)))
+                {
+                    break;
+                }
+                // Each movemask lane is two bits wide, so the popcounts are halved below.
+                unsigned const one_byte = _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(units, two_byte_mask), zero));
+                unsigned const up_to_two = _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(units, three_byte_mask), zero));
+                utf8_length += 24 - (__builtin_popcount(one_byte) + __builtin_popcount(up_to_two)) / 2;
+            }
+            return i + measure_utf16_scalar(input + i, length - i, utf8_length);
+        }
+
+        __attribute__((target("sse4.2")))
+        size_t count_equal_utf16_sse42(char16_t const* left, char16_t const* right, size_t length) noexcept
+        {
+            size_t i = 0;
+            for (; i + 8 <= length; i += 8)
+            {
+                __m128i const a = _mm_loadu_si128(reinterpret_cast<__m128i const*>(left + i));
+                __m128i const b = _mm_loadu_si128(reinterpret_cast<__m128i const*>(right + i));
+                unsigned const different = ~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi16(a, b))) & 0xFFFF;
+                if (different)
+                {
+                    return i + __builtin_ctz(different) / 2;
+                }
+            }
+            return i + count_equal_utf16_scalar(left + i, right + i, length - i);
+        }
+
+        __attribute__((target("sse4.2")))
+        size_t widen_utf8_sse42(uint8_t const* input, size_t length, char16_t* output, size_t& written) noexcept
+        {
+            __m128i const zero = _mm_setzero_si128();
+            size_t i = 0;
+            size_t units = 0;
+
+            // Sixteen bytes are loaded to decode eight, so the sequence starting at the eighth is always whole.
+            while (i + 16 <= length)
+            {
+                __m128i const bytes = _mm_loadu_si128(reinterpret_cast<__m128i const*>(input + i));
+                unsigned const continuation = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(bytes, _mm_set1_epi8(static_cast<char>(0xC0))), _mm_set1_epi8(static_cast<char>(0x80))));
+                unsigned const lead = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(bytes, _mm_set1_epi8(static_cast<char>(0xE0))), _mm_set1_epi8(static_cast<char>(0xC0))));
+                unsigned const longer = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(bytes, _mm_set1_epi8(static_cast<char>(0xE0))), bytes));
+                unsigned const overlong = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(bytes, _mm_set1_epi8(static_cast<char>(0xFE))), _mm_set1_epi8(static_cast<char>(0xC0))));
+
+                // Every continuation byte has to follow a two byte lead, and every lead precede one. Longer
+                // sequences and the overlong leads C0 and C1 are left to the scalar transcoder.
+                if (((longer | overlong) & 0xFF) || (continuation & 0xFF) != ((lead << 1) & 0xFF))
+                {
+                    break;
+                }
+
+                // A lead in the last position is decoded with the next block instead.
+                unsigned const split = (lead >> 7) & 1;
+                utf8_block const& block = utf8_blocks[continuation & 0xFF];
+
+                if (output)
+                {
+                    __m128i const lanes = _mm_shuffle_epi8(bytes, _mm_loadu_si128(reinterpret_cast<__m128i const*>(block.shuffle)));
+                    __m128i const two_byte = _mm_or_si128(
+                        _mm_slli_epi16(_mm_and_si128(_mm_srli_epi16(lanes, 8), _mm_set1_epi16(0x1F)), 6),
+                        _mm_and_si128(lanes, _mm_set1_epi16(0x3F)));
+                    __m128i const one_byte = _mm_cmpeq_epi16(_mm_srli_epi16(lanes, 8), zero);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + units), _mm_blendv_epi8(two_byte, lanes, one_byte));
+                }
+
+                units += block.units - split;
+                i += 8 - split;
+            }
+
+            written += units;
+            return i;
+        }
+
+        // Encodes four code units, zero extended to 32-bit lanes, storing 16 bytes of which the return value are used.
+        __attribute__((target("sse4.2")))
+        size_t encode_utf8_quad(__m128i const units, xlang_char8* output) noexcept
+        {
+            __m128i const last = _mm_or_si128(_mm_and_si128(units, _mm_set1_epi32(0x3F)), _mm_set1_epi32(0x80));
+            __m128i const middle = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(units, 6), _mm_set1_epi32(0x3F)), _mm_set1_epi32(0x80));
+            __m128i const two_byte = _mm_or_si128(_mm_or_si128(_mm_srli_epi32(units, 6), _mm_set1_epi32(0xC0)), _mm_slli_epi32(last, 8));
+            __m128i const three_byte = _mm_or_si128(
+                _mm_or_si128(_mm_srli_epi32(units, 12), _mm_set1_epi32(0xE0)),
+                _mm_or_si128(_mm_slli_epi32(middle, 8), _mm_slli_epi32(last, 16)));
+
+            __m128i const one = _mm_cmplt_epi32(units, _mm_set1_epi32(0x80));
+            __m128i const up_to_two = _mm_cmplt_epi32(units, _mm_set1_epi32(0x800));
+            __m128i const encoded = _mm_blendv_epi8(_mm_blendv_epi8(three_byte, two_byte, up_to_two), units, one);
+
+            unsigned const key = _mm_movemask_ps(_mm_castsi128_ps(one)) | (_mm_movemask_ps(_mm_castsi128_ps(up_to_two)) << 4);
+            utf16_quad const& quad = utf16_quads[key];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_shuffle_epi8(encoded, _mm_loadu_si128(reinterpret_cast<__m128i const*>(quad.shuffle))));
+            return quad.length;
+        }
+
+        __attribute__((target("sse4.2")))
+        size_t narrow_utf16_sse42(char16_t const* input, size_t length, xlang_char8* output, size_t capacity, size_t& written) noexcept
+        {
+            __m128i const surrogate_mask = _mm_set1_epi16(static_cast<short>(0xF800));
+            __m128i const surrogate_bits = _mm_set1_epi16(static_cast<short>(0xD800));
+            size_t i = 0;
+            size_t bytes = 0;
+
+            // Eight code units take at most 24 bytes, but the second store of 16 can start at byte 12.
+            for (; i + 8 <= length && bytes + 32 <= capacity; i += 8)
+            {
+                __m128i const units = _mm_loadu_si128(reinterpret_cast<__m128i const*>(input + i));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(units, surrogate_mask), surrogate_bits)))
+                {
+                    break;
+                }
+                bytes += encode_utf8_quad(_mm_cvtepu16_epi32(units), output + bytes);
+                bytes += encode_utf8_quad(_mm_cvtepu16_epi32(_mm_srli_si128(units, 8)), output + bytes);
+            }
+
+            written += bytes;
+            return i;
+        }
+
+        // AVX2 kernels, working on 256-bit vectors. Each finishes with its SSE4.2 counterpart, which is encoded
+        // without VEX, so the upper halves of the vector registers are cleared first; otherwise every call pays
+        // for a transition between AVX and legacy SSE state.
+
+        __attribute__((target("avx2")))
+        size_t widen_ascii_avx2(uint8_t const* input, size_t length, char16_t* output) noexcept
+        {
+            size_t i = 0;
+            for (; i + 32 <= length; i += 32)
+            {
+                __m256i const bytes = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(input + i));
+                if (_mm256_movemask_epi8(bytes))
+                {
+                    break;
+                }
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), _mm256_cvtepu8_epi16(_mm256_castsi256_si128(bytes)));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i + 16), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(bytes, 1)));
+            }
+            _mm256_zeroupper();
+            return i + widen_ascii_sse42(input + i, length - i, output + i);
+        }
+
+        __attribute__((target("avx2")))
+        size_t narrow_ascii_avx2(char16_t const* input, size_t length, xlang_char8* output) noexcept
+        {
+            __m256i const non_ascii = _mm256_set1_epi16(static_cast<short>(0xFF80));
+            size_t i = 0;
+            for (; i + 32 <= length; i += 32)
+            {
+                __m256i const lo = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(input + i));
+                __m256i const hi = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(input + i + 16));
+                if (!_mm256_testz_si256(_mm256_or_si256(lo, hi), non_ascii))
+                {
+                    break;
+                }
+                // packus interleaves 128-bit lanes; restore source order with a cross-lane permute.
+                __m256i const packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi), 0xD8);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), packed);
+            }
+            _mm256_zeroupper();
+            return i + narrow_ascii_sse42(input + i, length - i, output + i);
+        }
+
+        __attribute__((target("avx2")))
+        size_t count_ascii_avx2(uint8_t const* input, size_t length) noexcept
+        {
+            size_t i = 0;
+            for (; i + 32 <= length; i += 32)
+            {
+                __m256i const bytes = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(input + i));
+                if (_mm256_movemask_epi8(bytes))
+                {
+                    break;
+                }
+            }
+            _mm256_zeroupper();
+            return i + count_ascii_sse42(input + i, length - i);
+        }
+
+        __attribute__((target("avx2")))
+        size_t measure_utf16_avx2(char16_t const* input, size_t length, size_t& utf8_length) noexcept
+        {
+            __m256i const surrogate_mask = _mm256_set1_epi16(static_cast<short>(0xF800));
+            __m256i const surrogate_bits = _mm256_set1_epi16(static_cast<short>(0xD800));
+            __m256i const two_byte_mask = _mm256_set1_epi16(static_cast<short>(0xFF80));
+            __m256i const three_byte_mask = _mm256_set1_epi16(static_cast<short>(0xF800));
+            __m256i const zero = _mm256_setzero_si256();
+
+            size_t i = 0;
+            for (; i + 16 <= length; i += 16)
+            {
+                __m256i const units = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(input + i));
+                if (_mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_and_si256(units, surrogate_mask), surrogate_bits)))
+                {
+                    break;
+                }
+                unsigned const one_byte = _mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_and_si256(units, two_byte_mask), zero));
+                unsigned const up_to_two = _mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_and_si256(units, three_byte_mask), zero));
+                utf8_length += 48 - (__builtin_popcount(one_byte) + __builtin_popcount(up_to_two)) / 2;
+            }
+            _mm256_zeroupper();
+            return i + measure_utf16_sse42(input + i, length - i, utf8_length);
+        }
+
+        __attribute__((target("avx2")))
+        size_t count_equal_utf16_avx2(char16_t const* left, char16_t const* right, size_t length) noexcept
+        {
+            size_t i = 0;
+            for (; i + 16 <= length; i += 16)
+            {
+                __m256i const a = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(left + i));
+                __m256i const b = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(right + i));
+                unsigned const different = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(a, b)));
+                if (different)
+                {
+                    _mm256_zeroupper();
+                    return i + __builtin_ctz(different) / 2;
+                }
+            }
+            _mm256_zeroupper();
+            return i + count_equal_utf16_sse42(left + i, right + i, length - i);
+        }
+
+#endif
+
+        constexpr simd_kernels scalar_kernels{
+            widen_ascii_scalar, narrow_ascii_scalar, count_ascii_scalar, measure_utf16_scalar,
+            widen_utf8_scalar, narrow_utf16_scalar, count_equal_utf16_scalar, simd_level::scalar };
+
+#if XLANG_PAL_SIMD_X86
+        constexpr simd_kernels sse42_kernels{
+            widen_ascii_sse42, narrow_ascii_sse42, count_ascii_sse42, measure_utf16_sse42,
+            widen_utf8_sse42, narrow_utf16_sse42, count_equal_utf16_sse42, simd_level::sse42 };
+
+        // The multi-byte kernels are table driven shuffles of 16 bytes, which have no wider AVX2 form.
+        constexpr simd_kernels avx2_kernels{
+            widen_ascii_avx2, narrow_ascii_avx2, count_ascii_avx2, measure_utf16_avx2,
+            widen_utf8_sse42, narrow_utf16_sse42, count_equal_utf16_avx2, simd_level::avx2 };
+
+        simd_level requested_level() noexcept
+        {
+            using namespace std::string_view_literals;
+            char const* value = ::getenv("XLANG_PAL_SIMD");
+            if (value)
+            {
+                std::string_view const name{ value };
+                if (name == "scalar"sv)
+                {
+                    return simd_level::scalar;
+                }
+                if (name == "sse42"sv)
+                {
+                    return simd_level::sse42;
+                }
+            }
+            return simd_level::avx2;
+        }
+#endif
+
+        simd_kernels const& select_kernels() noexcept
+        {
+#if XLANG_PAL_SIMD_X86
+            simd_level const limit = requested_level();
+            __builtin_cpu_init();
+            if (limit >= simd_level::avx2 && __builtin_cpu_supports("avx2"))
+            {
+                return avx2_kernels;
+            }
+            if (limit >= simd_level::sse42 && __builtin_cpu_supports("sse4.2"))
+            {
+                return sse42_kernels;
+            }
+#endif
+            return scalar_kernels;
+        }
+    }
+
+    simd_kernels const& get_simd_kernels() noexcept
+    {
+        static simd_kernels const& kernels = select_kernels();
+        return kernels;
+    }
+}
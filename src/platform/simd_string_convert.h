@@ -0,0 +1,52 @@
+#pragma once
+
+#include "pal.h"
+#include <stddef.h>
+#include <stdint.h>
+
+namespace xlang::impl
+{
+    enum class simd_level : uint32_t
+    {
+        scalar,
+        sse42,
+        avx2,
+    };
+
+    // Vectorized building blocks for the non-Windows transcoder and string comparison. Every kernel handles the longest
+    // prefix of its input it can process without leaving its fast path, and returns the number of
+    // input code units it consumed. None of them validate: they stop in front of anything the scalar
+    // transcoder has to look at, which is where errors are detected and reported.
+    struct simd_kernels
+    {
+        // Copies leading ASCII bytes into UTF-16 code units.
+        size_t(*widen_ascii)(uint8_t const* input, size_t length, char16_t* output) noexcept;
+
+        // Copies leading ASCII UTF-16 code units into UTF-8 bytes.
+        size_t(*narrow_ascii)(char16_t const* input, size_t length, xlang_char8* output) noexcept;
+
+        // Counts leading ASCII bytes.
+        size_t(*count_ascii)(uint8_t const* input, size_t length) noexcept;
+
+        // Measures leading UTF-16 code units that are not surrogates, adding their UTF-8 length to utf8_length.
+        size_t(*measure_utf16)(char16_t const* input, size_t length, size_t& utf8_length) noexcept;
+
+        // Converts leading one and two byte UTF-8 sequences into UTF-16 code units, adding how many it wrote to
+        // written. When output is null, it only counts them. Stops in front of anything longer, and in front
+        // of any malformed sequence. Stores whole vector blocks, so output needs room for length code units.
+        size_t(*widen_utf8)(uint8_t const* input, size_t length, char16_t* output, size_t& written) noexcept;
+
+        // Converts leading UTF-16 code units that are not surrogates into UTF-8, writing at most capacity bytes and
+        // adding how many it wrote to written.
+        size_t(*narrow_utf16)(char16_t const* input, size_t length, xlang_char8* output, size_t capacity, size_t& written) noexcept;
+
+        // Counts leading UTF-16 code units that are the same in both inputs.
+        size_t(*count_equal_utf16)(char16_t const* left, char16_t const* right, size_t length) noexcept;
+
+        simd_level level;
+    };
+
+    // Selected once per process from the CPU features reported at runtime. The XLANG_PAL_SIMD
+    // environment variable ("scalar", "sse42" or "avx2") can lower, but never raise, the selected level.
+    simd_kernels const& get_simd_kernels() noexcept;
+}
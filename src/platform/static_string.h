@@ -0,0 +1,55 @@
+#pragma once
+
+#include "string_base.h"
+
+namespace xlang::impl
+{
+    // A string whose header and characters both have static storage duration. Duplicating one returns the
+    // same handle and deleting one does nothing, so a widely shared literal never touches a reference count.
+    // An alternate encoding, once created, is never released either.
+    struct static_string : string_base
+    {
+        template <typename char_type>
+        static static_string* create(
+            char_type const* source_string,
+            uint32_t length,
+            static_string* header
+        ) noexcept;
+
+    private:
+        static_string() = delete;
+        ~static_string() = delete;
+        static_string(static_string const&) = delete;
+        static_string& operator=(static_string const&) = delete;
+
+        // Private ctor that can only be used with placement new
+        template <typename char_type>
+        static_string(
+            char_type const* source_string,
+            uint32_t length
+        ) noexcept;
+    };
+
+    // Static strings initialize in the space allocated by xlang_string_header. Size must match.
+    static_assert(sizeof(static_string) == sizeof(xlang_string_header), "size mismatch");
+
+    template <typename char_type>
+    inline static_string* static_string::create(
+        char_type const* source_string,
+        uint32_t length,
+        static_string* header
+    ) noexcept
+    {
+        return (new (header) static_string{ source_string, length });
+    }
+
+    template <typename char_type>
+    inline static_string::static_string(
+        char_type const* source_string,
+        uint32_t length
+    ) noexcept
+        : string_base(source_string, length, string_flags::is_static)
+    {
+        static_assert(std::disjunction_v<std::is_same<char_type, xlang_char8>, std::is_same<char_type, char16_t>>, "char_t must be either xlang_char8 or char16_t");
+    }
+}
@@ -1,5 +1,10 @@
 #include "opaque_string_wrapper.h"
 #include "string_reference.h"
+#include "static_string.h"
+#include "string_compare.h"
+#include "string_arena.h"
+#include <limits>
+#include <memory>
 
 // Define the ABI-level implementations of string methods
 
@@ -36,6 +41,36 @@ namespace xlang::impl
         return nullptr;
     }
 
+    template <typename char_type>
+    xlang_string create_string_dual(char_type const* source_string, uint32_t length)
+    {
+        if (!source_string && length != 0)
+        {
+            xlang::throw_result(xlang_error_pointer);
+        }
+
+        if (length != 0)
+        {
+            return to_handle(heap_string::create_dual(source_string, length));
+        }
+        return nullptr;
+    }
+
+    template <typename char_type>
+    xlang_string create_string_interned(char_type const* source_string, uint32_t length)
+    {
+        if (!source_string && length != 0)
+        {
+            xlang::throw_result(xlang_error_pointer);
+        }
+
+        if (length != 0)
+        {
+            return to_handle(create_interned_string(source_string, length));
+        }
+        return nullptr;
+    }
+
     template <typename char_type>
     xlang_string create_string_reference(
         char_type const* source_string,
@@ -62,6 +97,105 @@ namespace xlang::impl
         return nullptr;
     }
 
+    template <typename char_type>
+    xlang_string create_string_static(
+        char_type const* source_string,
+        uint32_t length,
+        xlang_string_header* header
+    )
+    {
+        if (!source_string && length != 0)
+        {
+            xlang::throw_result(xlang_error_pointer);
+        }
+
+        if (source_string && source_string[length] != 0)
+        {
+            xlang::throw_result(xlang_error_string_not_null_terminated);
+        }
+
+        if (length != 0)
+        {
+            return to_handle(static_string::create(source_string, length, reinterpret_cast<static_string*>(header)));
+        }
+
+        return nullptr;
+    }
+
+    template <typename char_type>
+    xlang_string concat_strings(xlang_string const* strings, uint32_t count)
+    {
+        if (!strings && count != 0)
+        {
+            xlang::throw_result(xlang_error_pointer);
+        }
+
+        // Sizes are computed up front so the result is allocated exactly once, at its final length.
+        constexpr uint32_t max_stack_count = 16;
+        uint32_t stack_lengths[max_stack_count];
+        std::unique_ptr<uint32_t[]> heap_lengths;
+        uint32_t* lengths = stack_lengths;
+        if (count > max_stack_count)
+        {
+            heap_lengths = std::make_unique<uint32_t[]>(count);
+            lengths = heap_lengths.get();
+        }
+
+        uint32_t total{};
+        uint32_t non_empty{};
+        string_base* last_non_empty{};
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            lengths[i] = strings[i] ? get_length_as<char_type>(*from_handle(strings[i])) : 0;
+            if (std::numeric_limits<uint32_t>::max() - total < lengths[i])
+            {
+                xlang::throw_result(xlang_error_mem_invalid_size);
+            }
+            total += lengths[i];
+            if (lengths[i] != 0)
+            {
+                ++non_empty;
+                last_non_empty = from_handle(strings[i]);
+            }
+        }
+
+        if (non_empty == 1 && last_non_empty->is_utf8() == std::is_same_v<char_type, xlang_char8>)
+        {
+            // Nothing to concatenate with, and already in the right encoding
+            return to_handle(last_non_empty->duplicate_base());
+        }
+
+        heap_string* result = heap_string::create_preallocated<char_type>(total);
+        try
+        {
+            char_type* output = result->mutable_buffer<char_type>();
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                if (lengths[i] != 0)
+                {
+                    write_as(*from_handle(strings[i]), output, lengths[i]);
+                    output += lengths[i];
+                }
+            }
+        }
+        catch (...)
+        {
+            result->free_preallocated();
+            throw;
+        }
+        return to_handle(result->promote_preallocated(total));
+    }
+
+    template <typename char_type>
+    void string_builder_append(xlang_string_builder builder, char_type const* source_string, uint32_t length)
+    {
+        if (!builder || (!source_string && length != 0))
+        {
+            xlang::throw_result(xlang_error_pointer);
+        }
+        from_handle(builder)->append(std::basic_string_view<char_type>{ source_string, length });
+    }
+
     template <typename char_type>
     uint32_t xlang_get_string_raw_buffer(
         xlang_string string,
@@ -81,6 +215,75 @@ namespace xlang::impl
         }
     }
 
+    // Upper bound on the converted length, which lets a large enough buffer be converted into without measuring
+    // first: a UTF-16 code unit never needs more than three UTF-8 bytes, and a UTF-8 byte never more than one
+    // UTF-16 code unit.
+    inline uint64_t max_converted_length(std::basic_string_view<char16_t> source) noexcept
+    {
+        return uint64_t{ source.size() } * 3;
+    }
+
+    inline uint64_t max_converted_length(std::basic_string_view<xlang_char8> source) noexcept
+    {
+        return source.size();
+    }
+
+    template <typename char_type>
+    void copy_string_to_buffer(
+        xlang_string string,
+        char_type* buffer,
+        uint32_t buffer_length,
+        uint32_t& required_length
+    )
+    {
+        if (!buffer && buffer_length != 0)
+        {
+            xlang::throw_result(xlang_error_pointer);
+        }
+
+        auto const copy = [&](auto const& write)
+        {
+            if (!buffer)
+            {
+                return;
+            }
+            if (buffer_length <= required_length)
+            {
+                xlang::throw_result(xlang_error_insufficient_buffer);
+            }
+            write();
+            buffer[required_length] = 0;
+        };
+
+        string_base* value = from_handle(string);
+        if (!value)
+        {
+            required_length = 0;
+            copy([] {});
+            return;
+        }
+
+        if (auto const existing = value->try_get_buffer<char_type>())
+        {
+            required_length = static_cast<uint32_t>(existing->size());
+            copy([&] { std::copy(existing->begin(), existing->end(), buffer); });
+            return;
+        }
+
+        using source_type = typename alternate_type<char_type>::result_type;
+        std::basic_string_view<source_type> const source{ value->get_buffer<source_type>(), value->get_length() };
+        if (buffer && buffer_length > max_converted_length(source))
+        {
+            // Room for the worst case, so one pass both converts and measures.
+            required_length = convert_string(source, buffer, buffer_length - 1);
+            buffer[required_length] = 0;
+            return;
+        }
+
+        required_length = get_converted_length(source);
+        copy([&] { convert_string(source, buffer, required_length); });
+    }
+
     template <typename char_type>
     xlang_string_buffer preallocate_string_buffer(
         uint32_t length,
@@ -130,6 +333,40 @@ catch (...)
     return xlang::to_result();
 }
 
+XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_create_string_static_utf8(
+    xlang_char8 const* source_string,
+    uint32_t length,
+    xlang_string_header* header,
+    xlang_string* string
+) XLANG_NOEXCEPT
+try
+{
+    *string = xlang::impl::create_string_static(source_string, length, header);
+    return xlang_error_ok;
+}
+catch (...)
+{
+    *string = nullptr;
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_create_string_static_utf16(
+    char16_t const* source_string,
+    uint32_t length,
+    xlang_string_header* header,
+    xlang_string* string
+) XLANG_NOEXCEPT
+try
+{
+    *string = xlang::impl::create_string_static(source_string, length, header);
+    return xlang_error_ok;
+}
+catch (...)
+{
+    *string = nullptr;
+    return xlang::to_result();
+}
+
 XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_create_string_utf8(
     xlang_char8 const* source_string,
     uint32_t length,
@@ -162,6 +399,70 @@ catch (...)
     return xlang::to_result();
 }
 
+XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_create_string_dual_utf8(
+    xlang_char8 const* source_string,
+    uint32_t length,
+    xlang_string* string
+) XLANG_NOEXCEPT
+try
+{
+    *string = xlang::impl::create_string_dual(source_string, length);
+    return xlang_error_ok;
+}
+catch (...)
+{
+    *string = nullptr;
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_create_string_dual_utf16(
+    char16_t const* source_string,
+    uint32_t length,
+    xlang_string* string
+) XLANG_NOEXCEPT
+try
+{
+    *string = xlang::impl::create_string_dual(source_string, length);
+    return xlang_error_ok;
+}
+catch (...)
+{
+    *string = nullptr;
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_create_string_interned_utf8(
+    xlang_char8 const* source_string,
+    uint32_t length,
+    xlang_string* string
+) XLANG_NOEXCEPT
+try
+{
+    *string = xlang::impl::create_string_interned(source_string, length);
+    return xlang_error_ok;
+}
+catch (...)
+{
+    *string = nullptr;
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_create_string_interned_utf16(
+    char16_t const* source_string,
+    uint32_t length,
+    xlang_string* string
+) XLANG_NOEXCEPT
+try
+{
+    *string = xlang::impl::create_string_interned(source_string, length);
+    return xlang_error_ok;
+}
+catch (...)
+{
+    *string = nullptr;
+    return xlang::to_result();
+}
+
 XLANG_PAL_EXPORT void XLANG_CALL xlang_delete_string(xlang_string string) XLANG_NOEXCEPT
 {
     string_base* str = from_handle(string);
@@ -171,6 +472,44 @@ XLANG_PAL_EXPORT void XLANG_CALL xlang_delete_string(xlang_string string) XLANG_
     }
 }
 
+XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_create_strings_utf8(
+    xlang_string_source_utf8 const* sources,
+    uint32_t count,
+    xlang_string* strings
+) XLANG_NOEXCEPT
+try
+{
+    xlang::impl::create_strings(sources, count, strings);
+    return xlang_error_ok;
+}
+catch (...)
+{
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_create_strings_utf16(
+    xlang_string_source_utf16 const* sources,
+    uint32_t count,
+    xlang_string* strings
+) XLANG_NOEXCEPT
+try
+{
+    xlang::impl::create_strings(sources, count, strings);
+    return xlang_error_ok;
+}
+catch (...)
+{
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT void XLANG_CALL xlang_delete_strings(
+    xlang_string const* strings,
+    uint32_t count
+) XLANG_NOEXCEPT
+{
+    xlang::impl::delete_strings(strings, count);
+}
+
 XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_delete_string_buffer(xlang_string_buffer buffer_handle) XLANG_NOEXCEPT
 try
 {
@@ -228,6 +567,11 @@ XLANG_PAL_EXPORT xlang_string_encoding XLANG_CALL xlang_get_string_encoding(
     }
 }
 
+XLANG_PAL_EXPORT uint32_t XLANG_CALL xlang_get_string_layout_version() XLANG_NOEXCEPT
+{
+    return XLANG_STRING_LAYOUT_VERSION;
+}
+
 XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_get_string_raw_buffer_utf8(
     xlang_string string,
     xlang_char8 const* * buffer,
@@ -263,6 +607,48 @@ catch (...)
     return xlang::to_result();
 }
 
+XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_copy_string_to_buffer_utf8(
+    xlang_string string,
+    xlang_char8* buffer,
+    uint32_t buffer_length,
+    uint32_t* required_length
+) XLANG_NOEXCEPT
+try
+{
+    if (!required_length)
+    {
+        xlang::throw_result(xlang_error_pointer);
+    }
+    *required_length = 0;
+    xlang::impl::copy_string_to_buffer(string, buffer, buffer_length, *required_length);
+    return xlang_error_ok;
+}
+catch (...)
+{
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_copy_string_to_buffer_utf16(
+    xlang_string string,
+    char16_t* buffer,
+    uint32_t buffer_length,
+    uint32_t* required_length
+) XLANG_NOEXCEPT
+try
+{
+    if (!required_length)
+    {
+        xlang::throw_result(xlang_error_pointer);
+    }
+    *required_length = 0;
+    xlang::impl::copy_string_to_buffer(string, buffer, buffer_length, *required_length);
+    return xlang_error_ok;
+}
+catch (...)
+{
+    return xlang::to_result();
+}
+
 XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_preallocate_string_buffer_utf8(
     uint32_t length,
     xlang_char8** char_buffer,
@@ -298,6 +684,197 @@ catch (...)
     return xlang::to_result();
 }
 
+XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_hash_string(
+    xlang_string string,
+    uint32_t* hash
+) XLANG_NOEXCEPT
+try
+{
+    if (!hash)
+    {
+        xlang::throw_result(xlang_error_pointer);
+    }
+    *hash = hash_string(from_handle(string));
+    return xlang_error_ok;
+}
+catch (...)
+{
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_compare_string_ordinal(
+    xlang_string left,
+    xlang_string right,
+    int32_t* result
+) XLANG_NOEXCEPT
+try
+{
+    if (!result)
+    {
+        xlang::throw_result(xlang_error_pointer);
+    }
+    *result = compare_strings_ordinal(from_handle(left), from_handle(right));
+    return xlang_error_ok;
+}
+catch (...)
+{
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_concat_strings_utf8(
+    xlang_string const* strings,
+    uint32_t count,
+    xlang_string* string
+) XLANG_NOEXCEPT
+try
+{
+    *string = xlang::impl::concat_strings<xlang_char8>(strings, count);
+    return xlang_error_ok;
+}
+catch (...)
+{
+    *string = nullptr;
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_concat_strings_utf16(
+    xlang_string const* strings,
+    uint32_t count,
+    xlang_string* string
+) XLANG_NOEXCEPT
+try
+{
+    *string = xlang::impl::concat_strings<char16_t>(strings, count);
+    return xlang_error_ok;
+}
+catch (...)
+{
+    *string = nullptr;
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_create_string_builder_utf8(
+    uint32_t capacity,
+    xlang_string_builder* builder
+) XLANG_NOEXCEPT
+try
+{
+    *builder = to_builder_handle(string_builder::create<xlang_char8>(capacity));
+    return xlang_error_ok;
+}
+catch (...)
+{
+    *builder = nullptr;
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_create_string_builder_utf16(
+    uint32_t capacity,
+    xlang_string_builder* builder
+) XLANG_NOEXCEPT
+try
+{
+    *builder = to_builder_handle(string_builder::create<char16_t>(capacity));
+    return xlang_error_ok;
+}
+catch (...)
+{
+    *builder = nullptr;
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_string_builder_append_utf8(
+    xlang_string_builder builder,
+    xlang_char8 const* source_string,
+    uint32_t length
+) XLANG_NOEXCEPT
+try
+{
+    xlang::impl::string_builder_append(builder, source_string, length);
+    return xlang_error_ok;
+}
+catch (...)
+{
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_string_builder_append_utf16(
+    xlang_string_builder builder,
+    char16_t const* source_string,
+    uint32_t length
+) XLANG_NOEXCEPT
+try
+{
+    xlang::impl::string_builder_append(builder, source_string, length);
+    return xlang_error_ok;
+}
+catch (...)
+{
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_string_builder_append_string(
+    xlang_string_builder builder,
+    xlang_string string
+) XLANG_NOEXCEPT
+try
+{
+    if (!builder)
+    {
+        xlang::throw_result(xlang_error_pointer);
+    }
+
+    if (string)
+    {
+        from_handle(builder)->append(*from_handle(string));
+    }
+    return xlang_error_ok;
+}
+catch (...)
+{
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_promote_string_builder(
+    xlang_string_builder builder,
+    xlang_string* string
+) XLANG_NOEXCEPT
+try
+{
+    *string = nullptr;
+
+    if (!builder)
+    {
+        xlang::throw_result(xlang_error_pointer);
+    }
+
+    *string = to_handle(from_handle(builder)->promote());
+    delete from_handle(builder);
+    return xlang_error_ok;
+}
+catch (...)
+{
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_delete_string_builder(
+    xlang_string_builder builder
+) XLANG_NOEXCEPT
+try
+{
+    if (!builder)
+    {
+        xlang::throw_result(xlang_error_pointer);
+    }
+
+    delete from_handle(builder);
+    return xlang_error_ok;
+}
+catch (...)
+{
+    return xlang::to_result();
+}
+
 XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_promote_string_buffer(
     xlang_string_buffer buffer_handle,
     xlang_string* string,
@@ -0,0 +1,560 @@
+#include "string_allocator.h"
+#include "platform_memory.h"
+#include <atomic>
+#include <iterator>
+#include <mutex>
+#include <new>
+#include <stdint.h>
+
+namespace xlang::impl
+{
+    namespace
+    {
+        struct slab;
+        struct thread_cache;
+
+        // Precedes every block. Bits 1 and 2 hold the block's storage_kind. The rest holds the address of the
+        // slab the block came from or, for a block allocated individually, its size shifted left with the low
+        // bit set; slabs are aligned well beyond the bits used here.
+        struct alignas(8) block_header
+        {
+            static constexpr uintptr_t individual_bit = 1;
+            static constexpr uint32_t kind_shift = 1;
+            static constexpr uintptr_t kind_mask = uintptr_t{ 3 } << kind_shift;
+            static constexpr uint32_t size_shift = 3;
+
+            uintptr_t value;
+
+            slab* owner() const noexcept
+            {
+                return value & individual_bit ? nullptr : reinterpret_cast<slab*>(value & ~kind_mask);
+            }
+
+            size_t individual_size() const noexcept
+            {
+                return static_cast<size_t>(value >> size_shift);
+            }
+
+            storage_kind kind() const noexcept
+            {
+                return static_cast<storage_kind>((value & kind_mask) >> kind_shift);
+            }
+
+            void set_kind(storage_kind kind) noexcept
+            {
+                value |= static_cast<uintptr_t>(kind) << kind_shift;
+            }
+        };
+
+        static_assert(storage_kind_count <= (block_header::kind_mask >> block_header::kind_shift) + 1, "Kinds must fit in the header");
+
+        struct free_block
+        {
+            free_block* next;
+        };
+
+        // Block sizes, including the header. A UTF-16 heap_string of up to 63 characters fits in the largest.
+        constexpr uint32_t size_classes[] = { 48, 64, 96, 128, 192, 256 };
+        constexpr size_t size_class_count = std::size(size_classes);
+        constexpr uint32_t max_block_size = size_classes[size_class_count - 1];
+        constexpr size_t slab_size = 64 * 1024;
+
+        size_t size_class_index(size_t block_size) noexcept
+        {
+            size_t index = 0;
+            while (size_classes[index] < block_size)
+            {
+                ++index;
+            }
+            return index;
+        }
+
+        struct slab
+        {
+            slab(thread_cache* owning_cache, uint32_t size, uint32_t count) noexcept
+                : owner(owning_cache)
+                , block_size(size)
+                , capacity(count)
+            {}
+
+            // Only the owning thread allocates, and only it touches the local free list and the counters.
+            block_header* try_allocate() noexcept
+            {
+                void* block{};
+                if (local_free)
+                {
+                    block = local_free;
+                    local_free = local_free->next;
+                }
+                else if (bumped < capacity)
+                {
+                    block = blocks() + static_cast<size_t>(bumped++) * block_size;
+                }
+                else
+                {
+                    // Out of fresh blocks; reclaim everything other threads have returned since last time.
+                    local_free = take_remote_frees(nullptr);
+                    if (!local_free)
+                    {
+                        return nullptr;
+                    }
+                    block = local_free;
+                    local_free = local_free->next;
+                }
+
+                ++in_use;
+                auto header = static_cast<block_header*>(block);
+                header->value = reinterpret_cast<uintptr_t>(this);
+                return header;
+            }
+
+            void free(void* block, thread_cache* current) noexcept
+            {
+                auto node = static_cast<free_block*>(block);
+                if (owner.load(std::memory_order_relaxed) == current)
+                {
+                    node->next = local_free;
+                    local_free = node;
+                    --in_use;
+                    return;
+                }
+
+                free_block* head = remote_free.load(std::memory_order_relaxed);
+                do
+                {
+                    if (head == abandoned())
+                    {
+                        release_abandoned(-1);
+                        return;
+                    }
+                    node->next = head;
+                } while (!remote_free.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+            }
+
+            // Called by the owning thread when it stops allocating from this slab. From then on, frees settle
+            // against a shared count instead of going through the remote list, and the last one frees the slab.
+            void abandon() noexcept
+            {
+                owner.store(nullptr, std::memory_order_relaxed);
+                take_remote_frees(abandoned());
+                release_abandoned(in_use);
+            }
+
+            uint32_t size() const noexcept
+            {
+                return block_size;
+            }
+
+            static slab* create(thread_cache* owning_cache, uint32_t block_size)
+            {
+                void* memory = allocate_aligned_memory(slab_size, alignof(slab));
+                if (!memory)
+                {
+                    return nullptr;
+                }
+                uint32_t const count = static_cast<uint32_t>((slab_size - sizeof(slab)) / block_size);
+                return new (memory) slab(owning_cache, block_size, count);
+            }
+
+        private:
+            static free_block* abandoned() noexcept
+            {
+                return reinterpret_cast<free_block*>(uintptr_t{ 1 });
+            }
+
+            uint8_t* blocks() noexcept
+            {
+                return reinterpret_cast<uint8_t*>(this + 1);
+            }
+
+            free_block* take_remote_frees(free_block* replacement) noexcept
+            {
+                free_block* const list = remote_free.exchange(replacement, std::memory_order_acquire);
+                for (free_block* node = list; node; node = node->next)
+                {
+                    --in_use;
+                }
+                return list;
+            }
+
+            // The owner contributes its count of outstanding blocks once, when it abandons the slab; each
+            // block freed after that contributes -1. The two can arrive in either order, so the total only
+            // reaches zero once the owner has gone and every block has come back.
+            void release_abandoned(int64_t delta) noexcept
+            {
+                if (abandoned_balance.fetch_add(delta, std::memory_order_acq_rel) + delta == 0)
+                {
+                    this->~slab();
+                    free_aligned_memory(this, slab_size, alignof(slab));
+                }
+            }
+
+            std::atomic<thread_cache*> owner;
+            uint32_t const block_size;
+            uint32_t const capacity;
+            uint32_t bumped{};
+            uint32_t in_use{};
+            free_block* local_free{};
+
+            // Written by other threads, so kept off the owner's cache line.
+            alignas(64) std::atomic<free_block*> remote_free{};
+            std::atomic<int64_t> abandoned_balance{};
+        };
+
+        static_assert(sizeof(slab) % alignof(block_header) == 0, "Blocks must stay aligned");
+        static_assert(alignof(slab) > block_header::kind_mask, "Slab addresses must leave room for the kind");
+
+        // Running totals, by kind. Each thread_cache has its own set, written only by its thread with a plain
+        // load and store rather than a locked add, and read by xlang_get_diagnostics from any thread.
+        struct storage_counters
+        {
+            struct kind_totals
+            {
+                std::atomic<uint64_t> allocations;
+                std::atomic<uint64_t> frees;
+                std::atomic<uint64_t> allocated_bytes;
+                std::atomic<uint64_t> freed_bytes;
+            };
+
+            kind_totals kinds[storage_kind_count];
+
+            // Strings beyond the first in each arena, which the allocation counts don't see.
+            std::atomic<int64_t> extra_strings;
+        };
+
+        template <typename value_type>
+        void add_owned(std::atomic<value_type>& counter, value_type value) noexcept
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        template <typename value_type>
+        void add_shared(std::atomic<value_type>& counter, value_type value) noexcept
+        {
+            counter.fetch_add(value, std::memory_order_relaxed);
+        }
+
+        // Threads publish the change in their live byte count once it has moved by flush_threshold, so the
+        // high-water mark is only ever short by less than that for each thread, without every allocation
+        // updating a shared cache line.
+        constexpr int64_t flush_threshold = 64 * 1024;
+        std::atomic<int64_t> flushed_live_bytes{};
+        std::atomic<uint64_t> high_water_bytes{};
+
+        void raise_high_water(int64_t live_bytes) noexcept
+        {
+            uint64_t current = high_water_bytes.load(std::memory_order_relaxed);
+            while (live_bytes > 0 && static_cast<uint64_t>(live_bytes) > current &&
+                !high_water_bytes.compare_exchange_weak(current, static_cast<uint64_t>(live_bytes), std::memory_order_relaxed))
+            {
+            }
+        }
+
+        void flush_live_bytes(int64_t delta) noexcept
+        {
+            raise_high_water(flushed_live_bytes.fetch_add(delta, std::memory_order_relaxed) + delta);
+        }
+
+        // Trivially constructible and destructible, so accessing it is just a TLS lookup; cleanup at thread
+        // exit is registered separately, the first time the thread creates a slab.
+        struct thread_cache
+        {
+            block_header* allocate(size_t block_size);
+            void abandon_all() noexcept;
+
+            void record(storage_kind kind, uint64_t bytes, bool allocation) noexcept;
+            void adjust_live_strings(int64_t delta) noexcept;
+            void register_counters() noexcept;
+            void retire_counters() noexcept;
+
+            slab* slabs[size_class_count];
+            bool cleanup_registered;
+            bool destroyed;
+
+            bool counters_registered;
+            int64_t unflushed_bytes;
+            thread_cache* next_registered;
+            storage_counters counters;
+        };
+
+        // Every thread with counters, and the totals of threads that have exited. Counting after a thread's
+        // cleanup has run goes straight to the retired totals.
+        struct counter_registry
+        {
+            std::mutex mutex;
+            thread_cache* head{};
+            storage_counters retired{};
+        };
+
+        counter_registry registry;
+
+#if XLANG_COMPILER_CLANG
+        // Initial-exec skips __tls_get_addr on every access. The object is small enough for the static TLS
+        // surplus the loader keeps for libraries that are dlopen'd.
+        __attribute__((tls_model("initial-exec")))
+#endif
+        thread_local thread_cache current_thread_cache;
+
+        struct thread_cache_cleanup
+        {
+            ~thread_cache_cleanup()
+            {
+                current_thread_cache.abandon_all();
+                current_thread_cache.retire_counters();
+            }
+        };
+
+        thread_local thread_cache_cleanup current_thread_cleanup;
+
+        block_header* thread_cache::allocate(size_t block_size)
+        {
+            if (destroyed)
+            {
+                // Thread teardown; don't start slabs nobody will abandon.
+                return nullptr;
+            }
+
+            size_t const index = size_class_index(block_size);
+            slab*& current = slabs[index];
+            if (current)
+            {
+                if (block_header* block = current->try_allocate())
+                {
+                    return block;
+                }
+                current->abandon();
+                current = nullptr;
+            }
+
+            if (!cleanup_registered)
+            {
+                // The first odr-use constructs the thread's cleanup object, registering its destructor.
+                static_cast<void>(&current_thread_cleanup);
+                cleanup_registered = true;
+            }
+
+            current = slab::create(this, size_classes[index]);
+            return current ? current->try_allocate() : nullptr;
+        }
+
+        void thread_cache::record(storage_kind kind, uint64_t bytes, bool allocation) noexcept
+        {
+            int64_t const delta = allocation ? static_cast<int64_t>(bytes) : -static_cast<int64_t>(bytes);
+            if (destroyed)
+            {
+                auto& totals = registry.retired.kinds[static_cast<uint32_t>(kind)];
+                add_shared<uint64_t>(allocation ? totals.allocations : totals.frees, 1);
+                add_shared(allocation ? totals.allocated_bytes : totals.freed_bytes, bytes);
+                flush_live_bytes(delta);
+                return;
+            }
+
+            if (!counters_registered)
+            {
+                register_counters();
+            }
+            auto& totals = counters.kinds[static_cast<uint32_t>(kind)];
+            add_owned<uint64_t>(allocation ? totals.allocations : totals.frees, 1);
+            add_owned(allocation ? totals.allocated_bytes : totals.freed_bytes, bytes);
+
+            unflushed_bytes += delta;
+            if (unflushed_bytes >= flush_threshold || unflushed_bytes <= -flush_threshold)
+            {
+                flush_live_bytes(unflushed_bytes);
+                unflushed_bytes = 0;
+            }
+        }
+
+        void thread_cache::adjust_live_strings(int64_t delta) noexcept
+        {
+            if (destroyed)
+            {
+                add_shared(registry.retired.extra_strings, delta);
+                return;
+            }
+            if (!counters_registered)
+            {
+                register_counters();
+            }
+            add_owned(counters.extra_strings, delta);
+        }
+
+        void thread_cache::register_counters() noexcept
+        {
+            if (!cleanup_registered)
+            {
+                static_cast<void>(&current_thread_cleanup);
+                cleanup_registered = true;
+            }
+
+            std::lock_guard const lock{ registry.mutex };
+            next_registered = registry.head;
+            registry.head = this;
+            counters_registered = true;
+        }
+
+        void thread_cache::retire_counters() noexcept
+        {
+            if (!counters_registered)
+            {
+                return;
+            }
+
+            std::lock_guard const lock{ registry.mutex };
+            for (uint32_t i = 0; i < storage_kind_count; ++i)
+            {
+                auto& from = counters.kinds[i];
+                auto& to = registry.retired.kinds[i];
+                add_shared(to.allocations, from.allocations.load(std::memory_order_relaxed));
+                add_shared(to.frees, from.frees.load(std::memory_order_relaxed));
+                add_shared(to.allocated_bytes, from.allocated_bytes.load(std::memory_order_relaxed));
+                add_shared(to.freed_bytes, from.freed_bytes.load(std::memory_order_relaxed));
+            }
+            add_shared(registry.retired.extra_strings, counters.extra_strings.load(std::memory_order_relaxed));
+            flush_live_bytes(unflushed_bytes);
+            unflushed_bytes = 0;
+
+            thread_cache** link = &registry.head;
+            while (*link != this)
+            {
+                link = &(*link)->next_registered;
+            }
+            *link = next_registered;
+            counters_registered = false;
+        }
+
+        void thread_cache::abandon_all() noexcept
+        {
+            destroyed = true;
+            for (slab*& current : slabs)
+            {
+                if (current)
+                {
+                    current->abandon();
+                    current = nullptr;
+                }
+            }
+        }
+    }
+
+    void* allocate_string_storage(size_t size, storage_kind kind)
+    {
+        size_t const block_size = size + sizeof(block_header);
+        if (block_size < size || block_size > (SIZE_MAX >> block_header::size_shift))
+        {
+            throw std::bad_alloc{};
+        }
+
+        thread_cache& cache = current_thread_cache;
+        block_header* header{};
+        if (block_size <= max_block_size)
+        {
+            header = cache.allocate(block_size);
+        }
+
+        if (header)
+        {
+            cache.record(kind, header->owner()->size(), true);
+        }
+        else
+        {
+            header = static_cast<block_header*>(allocate_memory(block_size));
+            if (!header)
+            {
+                throw std::bad_alloc{};
+            }
+            header->value = (uintptr_t{ block_size } << block_header::size_shift) | block_header::individual_bit;
+            cache.record(kind, block_size, true);
+        }
+        header->set_kind(kind);
+        return header + 1;
+    }
+
+    void free_string_storage(void* ptr) noexcept
+    {
+        if (!ptr)
+        {
+            return;
+        }
+
+        thread_cache& cache = current_thread_cache;
+        block_header* header = static_cast<block_header*>(ptr) - 1;
+        if (slab* owner = header->owner())
+        {
+            // The slab may be freed along with the block, so count it first.
+            cache.record(header->kind(), owner->size(), false);
+            owner->free(header, &cache);
+        }
+        else
+        {
+            size_t const size = header->individual_size();
+            cache.record(header->kind(), size, false);
+            free_memory(header, size);
+        }
+    }
+
+    void adjust_live_string_count(int64_t delta) noexcept
+    {
+        current_thread_cache.adjust_live_strings(delta);
+    }
+
+    void get_string_storage_diagnostics(xlang_diagnostics& result) noexcept
+    {
+        uint64_t allocations[storage_kind_count]{};
+        uint64_t frees[storage_kind_count]{};
+        uint64_t allocated_bytes[storage_kind_count]{};
+        uint64_t freed_bytes[storage_kind_count]{};
+        int64_t extra_strings{};
+
+        auto const add = [&](storage_counters const& counters)
+        {
+            for (uint32_t i = 0; i < storage_kind_count; ++i)
+            {
+                allocations[i] += counters.kinds[i].allocations.load(std::memory_order_relaxed);
+                frees[i] += counters.kinds[i].frees.load(std::memory_order_relaxed);
+                allocated_bytes[i] += counters.kinds[i].allocated_bytes.load(std::memory_order_relaxed);
+                freed_bytes[i] += counters.kinds[i].freed_bytes.load(std::memory_order_relaxed);
+            }
+            extra_strings += counters.extra_strings.load(std::memory_order_relaxed);
+        };
+
+        {
+            std::lock_guard const lock{ registry.mutex };
+            add(registry.retired);
+            for (thread_cache* cache = registry.head; cache; cache = cache->next_registered)
+            {
+                add(cache->counters);
+            }
+        }
+
+        // A thread can free blocks that another allocated, so only the sums are meaningful.
+        auto const live = [&](storage_kind kind)
+        {
+            uint32_t const i = static_cast<uint32_t>(kind);
+            return allocations[i] - frees[i];
+        };
+        auto const live_bytes = [&](storage_kind kind)
+        {
+            uint32_t const i = static_cast<uint32_t>(kind);
+            return allocated_bytes[i] - freed_bytes[i];
+        };
+
+        result = {};
+        result.live_heap_strings = live(storage_kind::heap_string) + static_cast<uint64_t>(extra_strings);
+        result.live_reference_alternates = live(storage_kind::reference_alternate);
+        result.live_cache_alternates = live(storage_kind::cache_alternate);
+        result.heap_string_bytes = live_bytes(storage_kind::heap_string);
+        result.reference_alternate_bytes = live_bytes(storage_kind::reference_alternate);
+        result.cache_alternate_bytes = live_bytes(storage_kind::cache_alternate);
+        for (uint32_t i = 0; i < storage_kind_count; ++i)
+        {
+            result.allocation_count += allocations[i];
+            result.free_count += frees[i];
+            result.allocated_bytes += allocated_bytes[i];
+            result.freed_bytes += freed_bytes[i];
+        }
+
+        raise_high_water(static_cast<int64_t>(result.allocated_bytes - result.freed_bytes));
+        result.high_water_bytes = high_water_bytes.load(std::memory_order_relaxed);
+    }
+}
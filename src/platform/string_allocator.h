@@ -0,0 +1,50 @@
+#pragma once
+
+#include <stddef.h>
+#include "pal_internal.h"
+
+namespace xlang::impl
+{
+    // What a block of string storage holds, for xlang_get_diagnostics. Alternates are counted by the kind of
+    // string they were created for: reference_alternate covers string references and static strings.
+    enum class storage_kind : uint32_t
+    {
+        heap_string,         // Including string buffers, arenas and alternates embedded in dual strings
+        reference_alternate,
+        cache_alternate,
+    };
+
+    inline constexpr uint32_t storage_kind_count = 3;
+
+    // Storage for the packed string objects (heap_string and cache_string).
+    //
+    // Small blocks come from thread-local slabs carved into a handful of size classes. A block freed on the
+    // thread that owns its slab goes onto that slab's local free list; a block freed anywhere else is pushed
+    // onto the slab's lock-free remote list, which the owner reclaims the next time it runs out. When a thread
+    // exits, its slabs are abandoned rather than freed: each one outlives the thread for as long as any of its
+    // strings are alive, and the last string released frees it.
+    //
+    // Blocks larger than the biggest size class are allocated individually. Slabs and individual blocks
+    // alike come from the allocator installed with xlang_set_allocator, if any.
+    //
+    // This memory is private to the PAL: it must be released with free_string_storage, never xlang_mem_free.
+    //
+    // Every allocation and free is counted, by kind, in counters owned by the calling thread; reading them
+    // sums every thread's. Blocks count at their full size, header and size class rounding included.
+    void* allocate_string_storage(size_t size, storage_kind kind);
+    void free_string_storage(void* ptr) noexcept;
+
+    // For arenas, which hold several strings in one heap_string allocation: adjusts the live heap string
+    // count by the difference.
+    void adjust_live_string_count(int64_t delta) noexcept;
+
+    void get_string_storage_diagnostics(xlang_diagnostics& result) noexcept;
+
+    struct string_storage_deleter
+    {
+        void operator()(void* ptr) const noexcept
+        {
+            free_string_storage(ptr);
+        }
+    };
+}
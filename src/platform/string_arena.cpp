@@ -0,0 +1,188 @@
+#include "string_arena.h"
+#include "opaque_string_wrapper.h"
+#include <algorithm>
+
+namespace xlang::impl
+{
+    namespace
+    {
+        // [string_arena][member_header][heap_string][characters][padding][member_header][heap_string]...
+        struct alignas(heap_string) string_arena
+        {
+            std::atomic<uint32_t> live_members;
+        };
+
+        // Precedes each member, so a member can find its arena.
+        struct alignas(heap_string) member_header
+        {
+            string_arena* arena;
+        };
+
+        // Members bigger than this get blocks of their own. Arenas are kept small as well, since a single live
+        // member keeps its whole arena allocated.
+        constexpr uint32_t max_member_size = 256;
+        constexpr uint32_t max_arena_size = 16 * 1024;
+
+        template <typename char_type>
+        uint64_t member_size(uint32_t length) noexcept
+        {
+            constexpr uint64_t alignment_padding = alignof(heap_string) - 1;
+            uint64_t const size = sizeof(member_header) + sizeof(heap_string) + (uint64_t{ length } + 1) * sizeof(char_type);
+            return (size + alignment_padding) & ~alignment_padding;
+        }
+
+        string_arena* get_arena(heap_string* member) noexcept
+        {
+            return (reinterpret_cast<member_header*>(member) - 1)->arena;
+        }
+
+        // The allocator counts each arena as one heap string, so the rest of its members are counted here.
+        void release_members(string_arena* arena, uint32_t count) noexcept
+        {
+            if (!arena)
+            {
+                return;
+            }
+            if (arena->live_members.fetch_sub(count, std::memory_order_acq_rel) == count)
+            {
+                adjust_live_string_count(1 - static_cast<int64_t>(count));
+                free_string_storage(arena);
+            }
+            else
+            {
+                adjust_live_string_count(-static_cast<int64_t>(count));
+            }
+        }
+
+        // Sources are validated before anything is allocated, so only allocation can fail part way through.
+        template <typename char_type, typename source_type>
+        void create_strings_impl(source_type const* sources, uint32_t count, xlang_string* strings)
+        {
+            uint32_t first = 0;
+            while (first < count)
+            {
+                // Gather the run of small strings that fits in one arena.
+                uint32_t arena_size = sizeof(string_arena);
+                uint32_t members = 0;
+                uint32_t last = first;
+                for (; last < count; ++last)
+                {
+                    if (sources[last].length == 0)
+                    {
+                        continue;
+                    }
+                    uint64_t const size = member_size<char_type>(sources[last].length);
+                    if (size > max_member_size || arena_size + size > max_arena_size)
+                    {
+                        break;
+                    }
+                    arena_size += static_cast<uint32_t>(size);
+                    ++members;
+                }
+
+                if (members < 2)
+                {
+                    // Nothing to share a block with
+                    for (last = std::max(last, first + 1); first < last; ++first)
+                    {
+                        strings[first] = to_handle(heap_string::create(sources[first].source_string, sources[first].length));
+                    }
+                    continue;
+                }
+
+                uint8_t* block = static_cast<uint8_t*>(allocate_string_storage(arena_size, storage_kind::heap_string));
+                string_arena* arena = new (block) string_arena{ members };
+                adjust_live_string_count(members - 1);
+                uint8_t* next = block + sizeof(string_arena);
+                for (; first < last; ++first)
+                {
+                    if (sources[first].length != 0)
+                    {
+                        new (next) member_header{ arena };
+                        strings[first] = to_handle(heap_string::create_arena_member(next + sizeof(member_header), sources[first].source_string, sources[first].length));
+                        next += member_size<char_type>(sources[first].length);
+                    }
+                }
+                XLANG_ASSERT(next == block + arena_size);
+            }
+        }
+
+        template <typename source_type, typename char_type>
+        void create_strings(source_type const* sources, uint32_t count, xlang_string* strings)
+        {
+            if (count != 0 && (!sources || !strings))
+            {
+                throw_result(xlang_error_pointer);
+            }
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                if (!sources[i].source_string && sources[i].length != 0)
+                {
+                    throw_result(xlang_error_pointer);
+                }
+            }
+
+            std::fill_n(strings, count, nullptr);
+            try
+            {
+                create_strings_impl<char_type>(sources, count, strings);
+            }
+            catch (...)
+            {
+                delete_strings(strings, count);
+                std::fill_n(strings, count, nullptr);
+                throw;
+            }
+        }
+    }
+
+    void create_strings(xlang_string_source_utf8 const* sources, uint32_t count, xlang_string* strings)
+    {
+        create_strings<xlang_string_source_utf8, xlang_char8>(sources, count, strings);
+    }
+
+    void create_strings(xlang_string_source_utf16 const* sources, uint32_t count, xlang_string* strings)
+    {
+        create_strings<xlang_string_source_utf16, char16_t>(sources, count, strings);
+    }
+
+    void delete_strings(xlang_string const* strings, uint32_t count) noexcept
+    {
+        // Members of one arena are usually deleted together, as they were created, so their releases are
+        // gathered into one update of the arena's count.
+        string_arena* pending{};
+        uint32_t pending_count{};
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            string_base* str = from_handle(strings[i]);
+            if (!str)
+            {
+                continue;
+            }
+            if (!str->is_arena_member())
+            {
+                str->release_base();
+                continue;
+            }
+
+            auto member = static_cast<heap_string*>(str);
+            if (member->release_keeping_storage())
+            {
+                string_arena* arena = get_arena(member);
+                if (arena != pending)
+                {
+                    release_members(pending, pending_count);
+                    pending = arena;
+                    pending_count = 0;
+                }
+                ++pending_count;
+            }
+        }
+        release_members(pending, pending_count);
+    }
+
+    void release_arena_member(heap_string* str) noexcept
+    {
+        release_members(get_arena(str), 1);
+    }
+}
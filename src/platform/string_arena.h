@@ -0,0 +1,22 @@
+#pragma once
+
+#include "pal_internal.h"
+
+namespace xlang::impl
+{
+    struct heap_string;
+
+    // Creates count strings at once, as xlang_create_strings does. Runs of small strings are packed into
+    // arena blocks: each string in a block keeps its own reference count, and the block, which counts its live
+    // strings, is freed when the last of them is released. Larger strings, and small ones with no neighbours to
+    // share a block with, are allocated individually. Either every string is created, or none is and strings
+    // is left all null.
+    void create_strings(xlang_string_source_utf8 const* sources, uint32_t count, xlang_string* strings);
+    void create_strings(xlang_string_source_utf16 const* sources, uint32_t count, xlang_string* strings);
+
+    // Releases count strings. Neighbouring members of the same arena give back their share of it together.
+    void delete_strings(xlang_string const* strings, uint32_t count) noexcept;
+
+    // Called by an arena member whose last reference has been released, in place of freeing its storage.
+    void release_arena_member(heap_string* str) noexcept;
+}
@@ -1,12 +1,18 @@
 #include "string_base.h"
 #include "string_reference.h"
+#include "static_string.h"
 #include "heap_string.h"
 
 namespace xlang::impl
 {
     void string_base::release_base() noexcept
     {
-        if (this->is_reference())
+        if (this->is_static())
+        {
+            // Immortal, along with any alternate it has acquired
+            return;
+        }
+        else if (this->is_reference())
         {
             static_cast<string_reference*>(this)->release();
         }
@@ -18,7 +24,12 @@ namespace xlang::impl
 
     string_base* string_base::duplicate_base()
     {
-        if (this->is_reference())
+        if (this->is_static())
+        {
+            // Nothing to count, so no shared cache line to write either
+            return this;
+        }
+        else if (this->is_reference())
         {
             auto str = static_cast<string_reference*>(this);
             // This is a string reference. Create a ref counted string and return it.
@@ -3,6 +3,7 @@
 #include <atomic>
 #include <type_traits>
 #include <algorithm>
+#include <optional>
 #include "pal_internal.h"
 #include "cache_string.h"
 #include "string_traits.h"
@@ -14,6 +15,10 @@ namespace xlang::impl
     {
         none = 0x0000,         // None
         is_reference = 0x0001, // Whether this is a "fast" string
+        is_static = 0x0002,    // Header and characters have static storage duration; never copied or freed
+        is_interned = 0x0004,  // A heap_string registered in the intern table
+        has_embedded_alternate = 0x0008, // Alternate shares the heap_string's allocation and is freed with it
+        is_arena_member = 0x0010, // A heap_string packed into a block shared with others created in the same batch
         is_utf8 = 0x0020,      // Character pointer is UTF-8 data
 
         is_preallocated_string_buffer = 0xF8B10000,
@@ -55,6 +60,10 @@ namespace xlang::impl
 
     inline constexpr string_flags all_valid_flags =
         string_flags::is_reference |
+        string_flags::is_static |
+        string_flags::is_interned |
+        string_flags::has_embedded_alternate |
+        string_flags::is_arena_member |
         string_flags::is_utf8 |
         string_flags::reserved_for_preallocated_string_buffer;
 
@@ -97,6 +106,9 @@ namespace xlang::impl
     //      heap_string is a shared, immutable, heap-allocated string instance that packes the
     //          string header data and character data into a single allocation.
     //
+    //      static_string is an immortal string initialized into a caller-provided header, where
+    //          both the header and the characters outlive every use of the string.
+    //
     // cache_string holds is *NOT* a sub-class of string_base.
     //     It holds string buffer data when a raw buffer is requested in a different
     //     encoding than that of the original string_rerefence/heap_string
@@ -114,10 +126,19 @@ namespace xlang::impl
         template <typename char_type>
         char_type const* get_buffer() const noexcept;
 
+        // The characters in the requested encoding if the string already has them, natively or as its alternate.
+        // Unlike ensure_buffer, never converts.
+        template <typename char_type>
+        std::optional<std::basic_string_view<char_type>> try_get_buffer() const noexcept;
+
         bool is_reference() const noexcept;
+        bool is_static() const noexcept;
+        bool is_interned() const noexcept;
         bool is_preallocated_buffer() const noexcept;
         bool is_utf8() const noexcept;
         bool has_alternate() const noexcept;
+        bool has_embedded_alternate() const noexcept;
+        bool is_arena_member() const noexcept;
 
     protected:
         string_base() = delete;
@@ -132,6 +153,9 @@ namespace xlang::impl
         string_base(char_type const* storage, uint32_t length, string_flags new_flags = string_flags::none) noexcept;
 
         void promote_string_buffer_flags() noexcept;
+        void set_interned_flag() noexcept;
+        void set_embedded_alternate_flag() noexcept;
+        void set_arena_member_flag() noexcept;
 
         // Get or set the alternate representation string, in a thread-safe manner
         template <typename alternate_type>
@@ -151,6 +175,15 @@ namespace xlang::impl
     // This class is a wrapper, need to be able to up-cast safely, which means layout can't change.
     static_assert(sizeof(string_base) == sizeof(string_storage_base), "Class layout must match");
 
+    // The inline accessors in pal.h read string headers through xlang_string_layout. Changing anything checked
+    // here means changing XLANG_STRING_LAYOUT_VERSION too.
+    static_assert(sizeof(xlang_string_layout) == sizeof(string_storage_base), "Published layout must match");
+    static_assert(offsetof(xlang_string_layout, flags) == offsetof(string_storage_base, flags), "Published layout must match");
+    static_assert(offsetof(xlang_string_layout, length) == offsetof(string_storage_base, length_), "Published layout must match");
+    static_assert(offsetof(xlang_string_layout, alternate) == offsetof(string_storage_base, alternate_form), "Published layout must match");
+    static_assert(offsetof(xlang_string_layout, buffer) == offsetof(string_storage_base, string_ref), "Published layout must match");
+    static_assert(static_cast<uint32_t>(string_flags::is_utf8) == XLANG_STRING_LAYOUT_UTF8, "Published flag must match");
+
     inline uint32_t string_base::get_length() const noexcept
     {
         return this->length_;
@@ -162,11 +195,35 @@ namespace xlang::impl
         return reinterpret_cast<char_type const*>(this->string_ref);
     }
 
+    template <typename char_type>
+    inline std::optional<std::basic_string_view<char_type>> string_base::try_get_buffer() const noexcept
+    {
+        if (is_utf8() == std::is_same_v<char_type, xlang_char8>)
+        {
+            return std::basic_string_view<char_type>{ get_buffer<char_type>(), get_length() };
+        }
+        if (cache_string const* alternate = get_alternate_ptr<cache_string>())
+        {
+            return std::basic_string_view<char_type>{ alternate->get_buffer<char_type>(), alternate->get_length() };
+        }
+        return std::nullopt;
+    }
+
     inline bool string_base::is_reference() const noexcept
     {
         return (flags & string_flags::is_reference) != string_flags::none;
     }
 
+    inline bool string_base::is_static() const noexcept
+    {
+        return (flags & string_flags::is_static) != string_flags::none;
+    }
+
+    inline bool string_base::is_interned() const noexcept
+    {
+        return (flags & string_flags::is_interned) != string_flags::none;
+    }
+
     inline bool string_base::is_preallocated_buffer() const noexcept
     {
         return (flags & string_flags::reserved_for_preallocated_string_buffer) == string_flags::is_preallocated_string_buffer;
@@ -182,6 +239,16 @@ namespace xlang::impl
         return get_alternate_ptr<cache_string>();
     }
 
+    inline bool string_base::has_embedded_alternate() const noexcept
+    {
+        return (flags & string_flags::has_embedded_alternate) != string_flags::none;
+    }
+
+    inline bool string_base::is_arena_member() const noexcept
+    {
+        return (flags & string_flags::is_arena_member) != string_flags::none;
+    }
+
     template <typename char_type>
     inline string_base::string_base(char_type const* storage, uint32_t length, string_flags new_flags) noexcept
         : string_storage_base{}
@@ -204,6 +271,21 @@ namespace xlang::impl
         flags = preserved;
     }
 
+    inline void string_base::set_interned_flag() noexcept
+    {
+        flags |= string_flags::is_interned;
+    }
+
+    inline void string_base::set_embedded_alternate_flag() noexcept
+    {
+        flags |= string_flags::has_embedded_alternate;
+    }
+
+    inline void string_base::set_arena_member_flag() noexcept
+    {
+        flags |= string_flags::is_arena_member;
+    }
+
     template <typename alternate_type>
     inline alternate_type const* string_base::get_alternate_ptr() const noexcept
     {
@@ -255,7 +337,8 @@ namespace xlang::impl
             cache_string* alternate = get_alternate_ptr<cache_string>();
             if (!alternate)
             {
-                auto new_alternate = cache_string::create(get_buffer<my_char_type>(), get_length());
+                storage_kind const kind = is_reference() || is_static() ? storage_kind::reference_alternate : storage_kind::cache_alternate;
+                auto new_alternate = cache_string::create(get_buffer<my_char_type>(), get_length(), kind);
                 alternate = set_alternate_ptr<cache_string>(new_alternate.get());
                 if (alternate == new_alternate.get())
                 {
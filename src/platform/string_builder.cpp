@@ -0,0 +1,159 @@
+#include "string_builder.h"
+#include "string_convert.h"
+#include <limits>
+#include <utility>
+
+namespace xlang::impl
+{
+    namespace
+    {
+        template <typename char_type>
+        using other_char_type = typename alternate_type<char_type>::result_type;
+
+        uint32_t checked_add(uint32_t lhs, uint32_t rhs)
+        {
+            if (std::numeric_limits<uint32_t>::max() - lhs < rhs)
+            {
+                throw_result(xlang_error_mem_invalid_size);
+            }
+            return lhs + rhs;
+        }
+    }
+
+    template <typename char_type>
+    string_builder* string_builder::create(uint32_t capacity)
+    {
+        heap_string* initial_buffer = heap_string::create_preallocated<char_type>(capacity);
+        try
+        {
+            return new string_builder(initial_buffer, capacity);
+        }
+        catch (...)
+        {
+            initial_buffer->free_preallocated();
+            throw;
+        }
+    }
+
+    template string_builder* string_builder::create<xlang_char8>(uint32_t capacity);
+    template string_builder* string_builder::create<char16_t>(uint32_t capacity);
+
+    string_builder::~string_builder() noexcept
+    {
+        if (buffer)
+        {
+            buffer->release();
+        }
+    }
+
+    void string_builder::append(std::basic_string_view<xlang_char8> value)
+    {
+        if (buffer->is_utf8())
+        {
+            append_native(value);
+        }
+        else
+        {
+            append_converted(value);
+        }
+    }
+
+    void string_builder::append(std::basic_string_view<char16_t> value)
+    {
+        if (buffer->is_utf8())
+        {
+            append_converted(value);
+        }
+        else
+        {
+            append_native(value);
+        }
+    }
+
+    void string_builder::append(string_base& value)
+    {
+        if (buffer->is_utf8())
+        {
+            uint32_t const count = get_length_as<xlang_char8>(value);
+            write_as(value, reserve<xlang_char8>(count), count);
+            length += count;
+        }
+        else
+        {
+            uint32_t const count = get_length_as<char16_t>(value);
+            write_as(value, reserve<char16_t>(count), count);
+            length += count;
+        }
+    }
+
+    heap_string* string_builder::promote()
+    {
+        // Promotion only shrinks the length, so the unused capacity stays with the string rather than being copied away.
+        heap_string* result = std::exchange(buffer, nullptr);
+        return result->promote_preallocated(length);
+    }
+
+    template <typename char_type>
+    void string_builder::append_native(std::basic_string_view<char_type> value)
+    {
+        uint32_t const count = static_cast<uint32_t>(value.size());
+        std::copy(value.begin(), value.end(), reserve<char_type>(count));
+        length += count;
+    }
+
+    template <typename source_type>
+    void string_builder::append_converted(std::basic_string_view<source_type> value)
+    {
+        using char_type = other_char_type<source_type>;
+        uint32_t const count = get_converted_length(value);
+        convert_string(value, reserve<char_type>(count), count);
+        length += count;
+    }
+
+    template <typename char_type>
+    char_type* string_builder::reserve(uint32_t count)
+    {
+        uint32_t const required = checked_add(length, count);
+        if (required > capacity)
+        {
+            uint32_t new_capacity = capacity > std::numeric_limits<uint32_t>::max() / 2 ? std::numeric_limits<uint32_t>::max() : capacity * 2;
+            new_capacity = std::max({ new_capacity, required, uint32_t{ 16 } });
+
+            heap_string* new_buffer = heap_string::create_preallocated<char_type>(new_capacity);
+            std::copy_n(buffer->mutable_buffer<char_type>(), length, new_buffer->mutable_buffer<char_type>());
+            buffer->free_preallocated();
+            buffer = new_buffer;
+            capacity = new_capacity;
+        }
+        return buffer->mutable_buffer<char_type>() + length;
+    }
+
+    template <typename char_type>
+    uint32_t get_length_as(string_base& value)
+    {
+        if (auto const existing = value.try_get_buffer<char_type>())
+        {
+            return static_cast<uint32_t>(existing->size());
+        }
+        return get_converted_length(std::basic_string_view<other_char_type<char_type>>{ value.get_buffer<other_char_type<char_type>>(), value.get_length() });
+    }
+
+    template <typename char_type>
+    void write_as(string_base& value, char_type* output, uint32_t length)
+    {
+        if (auto const existing = value.try_get_buffer<char_type>())
+        {
+            XLANG_ASSERT(existing->size() == length);
+            std::copy(existing->begin(), existing->end(), output);
+        }
+        else
+        {
+            convert_string(std::basic_string_view<other_char_type<char_type>>{ value.get_buffer<other_char_type<char_type>>(), value.get_length() }, output, length);
+        }
+    }
+
+    template uint32_t get_length_as<xlang_char8>(string_base& value);
+    template uint32_t get_length_as<char16_t>(string_base& value);
+    template void write_as<xlang_char8>(string_base& value, xlang_char8* output, uint32_t length);
+    template void write_as<char16_t>(string_base& value, char16_t* output, uint32_t length);
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "heap_string.h"
+#include <string_view>
+
+namespace xlang::impl
+{
+    // Builds a string in the buffer of a preallocated heap_string, growing it as needed. Promoting hands that
+    // heap_string over as is, so characters are written once, straight into the final string. Input in the
+    // other encoding is transcoded directly into the buffer.
+    struct string_builder
+    {
+        template <typename char_type>
+        static string_builder* create(uint32_t capacity);
+
+        ~string_builder() noexcept;
+
+        // On failure, including invalid input in the other encoding, the builder is left unchanged.
+        void append(std::basic_string_view<xlang_char8> value);
+        void append(std::basic_string_view<char16_t> value);
+        void append(string_base& value);
+
+        // Transfers the built string to the caller, who then deletes the builder.
+        heap_string* promote();
+
+    private:
+        explicit string_builder(heap_string* initial_buffer, uint32_t initial_capacity) noexcept
+            : buffer(initial_buffer)
+            , capacity(initial_capacity)
+        {}
+
+        string_builder(string_builder const&) = delete;
+        string_builder& operator=(string_builder const&) = delete;
+
+        template <typename char_type>
+        void append_native(std::basic_string_view<char_type> value);
+
+        template <typename source_type>
+        void append_converted(std::basic_string_view<source_type> value);
+
+        template <typename char_type>
+        char_type* reserve(uint32_t count);
+
+        heap_string* buffer{};
+        uint32_t capacity{};
+        uint32_t length{};
+    };
+
+    // Writes a string's characters in the requested encoding to output, which must hold exactly
+    // get_length_as<char_type>(value) elements. Converts directly when the string has no such buffer yet.
+    template <typename char_type>
+    uint32_t get_length_as(string_base& value);
+
+    template <typename char_type>
+    void write_as(string_base& value, char_type* output, uint32_t length);
+}
@@ -0,0 +1,263 @@
+#include "string_compare.h"
+#include "string_convert.h"
+#include "heap_string.h"
+#include <algorithm>
+#include <iterator>
+#include <string.h>
+#include <string_view>
+
+#ifndef _WIN32
+#include "simd_string_convert.h"
+#endif
+
+namespace xlang::impl
+{
+    namespace
+    {
+        constexpr bool is_high_surrogate(char16_t c) noexcept
+        {
+            return (c & 0xFC00) == 0xD800;
+        }
+
+        constexpr bool is_continuation(xlang_char8 c) noexcept
+        {
+            return (static_cast<uint8_t>(c) & 0xC0) == 0x80;
+        }
+
+        // Moves surrogates above the rest of the BMP, so that UTF-16 code units order the way the code points
+        // they encode do. Only needed where two strings first differ; equal prefixes compare equal either way.
+        constexpr uint32_t code_point_order(char16_t c) noexcept
+        {
+            return c < 0xD800 ? c : c < 0xE000 ? c + 0x2000u : c - 0x800u;
+        }
+
+        size_t count_equal(char16_t const* left, char16_t const* right, size_t length) noexcept
+        {
+#ifdef _WIN32
+            // The Visual C++ library vectorizes mismatch.
+            return static_cast<size_t>(std::mismatch(left, left + length, right).first - left);
+#else
+            return get_simd_kernels().count_equal_utf16(left, right, length);
+#endif
+        }
+
+        int32_t compare_lengths(size_t left, size_t right) noexcept
+        {
+            return left < right ? -1 : left > right ? 1 : 0;
+        }
+
+        // Byte order is code point order for UTF-8, so memcmp's vectorized implementation does all the work.
+        int32_t compare(std::basic_string_view<xlang_char8> left, std::basic_string_view<xlang_char8> right) noexcept
+        {
+            int const result = memcmp(left.data(), right.data(), std::min(left.size(), right.size()));
+            if (result != 0)
+            {
+                return result < 0 ? -1 : 1;
+            }
+            return compare_lengths(left.size(), right.size());
+        }
+
+        int32_t compare(std::basic_string_view<char16_t> left, std::basic_string_view<char16_t> right) noexcept
+        {
+            size_t const common = std::min(left.size(), right.size());
+            size_t const equal = count_equal(left.data(), right.data(), common);
+            if (equal != common)
+            {
+                return code_point_order(left[equal]) < code_point_order(right[equal]) ? -1 : 1;
+            }
+            return compare_lengths(left.size(), right.size());
+        }
+
+        // With neither encoding available on both sides, the UTF-8 side is converted a piece at a time into a
+        // buffer on the stack, so nothing is allocated and nothing is attached to either string.
+        int32_t compare(std::basic_string_view<xlang_char8> left, std::basic_string_view<char16_t> right)
+        {
+            constexpr size_t chunk_size = 256;
+            char16_t buffer[chunk_size];
+
+            while (!left.empty())
+            {
+                size_t count = std::min(left.size(), chunk_size);
+                if (count < left.size())
+                {
+                    // End the piece on a code point boundary. Malformed input is left for convert_string to reject.
+                    size_t boundary = count;
+                    while (boundary > 0 && is_continuation(left[boundary]))
+                    {
+                        --boundary;
+                    }
+                    count = boundary > 0 ? boundary : count;
+                }
+
+                size_t const converted = convert_string(left.substr(0, count), buffer, chunk_size);
+                size_t const common = std::min(converted, right.size());
+                size_t const equal = count_equal(buffer, right.data(), common);
+                if (equal != common)
+                {
+                    return code_point_order(buffer[equal]) < code_point_order(right[equal]) ? -1 : 1;
+                }
+                if (common != converted)
+                {
+                    return 1;
+                }
+
+                left.remove_prefix(count);
+                right.remove_prefix(converted);
+            }
+            return right.empty() ? 0 : -1;
+        }
+
+        // A single lane of 64-bit multiply-rotate rounds over eight-byte words, with the length and a final mix
+        // folded in at the end. Input may arrive in pieces; the result depends only on the concatenated bytes.
+        struct text_hasher
+        {
+            void update(xlang_char8 const* data, size_t size) noexcept
+            {
+                total += size;
+                if (pending_count != 0)
+                {
+                    size_t const count = std::min(size, sizeof(pending) - pending_count);
+                    memcpy(pending + pending_count, data, count);
+                    pending_count += count;
+                    data += count;
+                    size -= count;
+                    if (pending_count != sizeof(pending))
+                    {
+                        return;
+                    }
+                    round(load(pending));
+                    pending_count = 0;
+                }
+
+                for (; size >= sizeof(uint64_t); data += sizeof(uint64_t), size -= sizeof(uint64_t))
+                {
+                    round(load(data));
+                }
+                memcpy(pending, data, size);
+                pending_count = size;
+            }
+
+            uint32_t finish() noexcept
+            {
+                uint64_t tail{};
+                memcpy(&tail, pending, pending_count);
+                round(tail);
+
+                uint64_t value = state ^ total;
+                value ^= value >> 33;
+                value *= 0xFF51AFD7ED558CCDull;
+                value ^= value >> 33;
+                value *= 0xC4CEB9FE1A85EC53ull;
+                value ^= value >> 33;
+                return static_cast<uint32_t>(value ^ (value >> 32));
+            }
+
+        private:
+            static uint64_t load(void const* data) noexcept
+            {
+                uint64_t value;
+                memcpy(&value, data, sizeof(value));
+                return value;
+            }
+
+            void round(uint64_t word) noexcept
+            {
+                // word's multiply doesn't depend on state, so only the xor, rotate and one multiply are serialized.
+                uint64_t const mixed = state ^ (word * 0xC2B2AE3D27D4EB4Full);
+                state = ((mixed << 31) | (mixed >> 33)) * 0x9E3779B185EBCA87ull;
+            }
+
+            uint64_t state{ 0x27D4EB2F165667C5ull };
+            uint64_t total{};
+            xlang_char8 pending[sizeof(uint64_t)]{};
+            size_t pending_count{};
+        };
+
+        void hash_text(text_hasher& hasher, std::basic_string_view<char16_t> value)
+        {
+            constexpr size_t chunk_size = 128;
+            xlang_char8 buffer[chunk_size * 3];
+
+            while (!value.empty())
+            {
+                size_t count = std::min(value.size(), chunk_size);
+                if (count < value.size() && is_high_surrogate(value[count - 1]))
+                {
+                    // Keep surrogate pairs in one piece
+                    --count;
+                }
+
+                uint32_t const converted = convert_string(value.substr(0, count), buffer, static_cast<uint32_t>(std::size(buffer)));
+                hasher.update(buffer, converted);
+                value.remove_prefix(count);
+            }
+        }
+
+        uint32_t compute_hash(string_base const& value)
+        {
+            text_hasher hasher;
+            if (auto utf8 = value.try_get_buffer<xlang_char8>())
+            {
+                hasher.update(utf8->data(), utf8->size());
+            }
+            else
+            {
+                hash_text(hasher, { value.get_buffer<char16_t>(), value.get_length() });
+            }
+            return hasher.finish();
+        }
+    }
+
+    uint32_t hash_string(string_base const* value)
+    {
+        if (!value)
+        {
+            return text_hasher{}.finish();
+        }
+
+        if (value->is_reference() || value->is_static())
+        {
+            // Their headers have no room to spare
+            return compute_hash(*value);
+        }
+
+        auto const heap_value = static_cast<heap_string const*>(value);
+        uint32_t hash = heap_value->get_cached_hash();
+        if (hash == 0)
+        {
+            // A hash that really is zero just isn't remembered.
+            hash = compute_hash(*value);
+            heap_value->set_cached_hash(hash);
+        }
+        return hash;
+    }
+
+    int32_t compare_strings_ordinal(string_base const* left, string_base const* right)
+    {
+        if (!left || !right)
+        {
+            return compare_lengths(left ? left->get_length() : 0, right ? right->get_length() : 0);
+        }
+        if (left == right)
+        {
+            return 0;
+        }
+
+        // Prefer an encoding both strings already have, natively or as an alternate.
+        auto const left_utf8 = left->try_get_buffer<xlang_char8>();
+        auto const right_utf8 = right->try_get_buffer<xlang_char8>();
+        if (left_utf8 && right_utf8)
+        {
+            return compare(*left_utf8, *right_utf8);
+        }
+
+        auto const left_utf16 = left->try_get_buffer<char16_t>();
+        auto const right_utf16 = right->try_get_buffer<char16_t>();
+        if (left_utf16 && right_utf16)
+        {
+            return compare(*left_utf16, *right_utf16);
+        }
+
+        return left_utf8 ? compare(*left_utf8, *right_utf16) : -compare(*right_utf8, *left_utf16);
+    }
+}
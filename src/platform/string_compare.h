@@ -0,0 +1,17 @@
+#pragma once
+
+#include "pal_internal.h"
+
+namespace xlang::impl
+{
+    struct string_base;
+
+    // Hash of the string's text, independent of its encoding: equal text yields equal hashes whether the
+    // strings hold UTF-8 or UTF-16. Computed over the UTF-8 form. Heap strings remember the result, so each one
+    // is hashed at most once. A null string is the empty string.
+    uint32_t hash_string(string_base const* value);
+
+    // Orders strings by Unicode code point, regardless of encoding, returning a negative number, zero or a
+    // positive number. A null string is the empty string.
+    int32_t compare_strings_ordinal(string_base const* left, string_base const* right);
+}
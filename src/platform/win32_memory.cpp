@@ -1,19 +1,30 @@
-#include "pal.h"
+#include "platform_memory.h"
 #include <objbase.h>
 
 #if !XLANG_PLATFORM_WINDOWS
 #error "This file is only for targeting Windows"
 #endif
 
-extern "C"
+namespace xlang::impl
 {
-    void* XLANG_CALL xlang_mem_alloc(size_t count) XLANG_NOEXCEPT
+    namespace
     {
-        return ::CoTaskMemAlloc(count);
+        void* XLANG_CALL platform_alloc(void*, size_t count)
+        {
+            return ::CoTaskMemAlloc(count);
+        }
+
+        void XLANG_CALL platform_free(void*, void* ptr)
+        {
+            ::CoTaskMemFree(ptr);
+        }
+
+        // No aligned variant of CoTaskMemAlloc; the PAL over-allocates instead.
+        constexpr xlang_allocator platform_allocator{ nullptr, platform_alloc, platform_free, nullptr, nullptr, nullptr };
     }
 
-    void XLANG_CALL xlang_mem_free(void* ptr) XLANG_NOEXCEPT
+    xlang_allocator const& get_platform_allocator() noexcept
     {
-        return ::CoTaskMemFree(ptr);
+        return platform_allocator;
     }
 }
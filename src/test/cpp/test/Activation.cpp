@@ -0,0 +1,57 @@
+#include "pch.h"
+
+using namespace winrt;
+using namespace Windows::Foundation;
+
+// The class name dispatch in the generated module.g.cpp, which hashes the names of the component's activatable
+// classes with the same perfect_hash_key and perfect_hash_slot the cpp tool built the table with.
+
+void* WINRT_CALL test_get_activation_factory(std::wstring_view const& name);
+
+namespace
+{
+    std::wstring_view const activatable[]
+    {
+        L"Component.Edge.StaticClass",
+        L"Component.Edge.ZeroClass",
+        L"Component.Edge.OneClass",
+        L"Component.Edge.TwoClass",
+        L"Component.Edge.ThreeClass",
+        L"Component.Fast.SlowClass",
+        L"Component.Fast.FastClass",
+        L"Component.Result.Class",
+        L"Component.Async.Class",
+        L"Component.Collections.Class",
+    };
+
+    IActivationFactory get_factory(std::wstring_view const& name)
+    {
+        return { test_get_activation_factory(name), take_ownership_from_abi };
+    }
+}
+
+TEST_CASE("Activation")
+{
+    for (auto&& name : activatable)
+    {
+        REQUIRE(get_factory(name));
+    }
+
+    // Names that share a hash slot, length or suffix with a class must still fail the compare.
+    REQUIRE(!get_factory(L""));
+    REQUIRE(!get_factory(L"Component.Edge.EmptyClass"));
+    REQUIRE(!get_factory(L"Component.Edge.ZeroClasz"));
+    REQUIRE(!get_factory(L"Xomponent.Edge.ZeroClass"));
+    REQUIRE(!get_factory(L"Edge.ZeroClass"));
+}
+
+TEST_CASE("Activation benchmark", "[.][benchmark]")
+{
+    size_t next{};
+
+    BENCHMARK("test_get_activation_factory")
+    {
+        get_factory(activatable[next]);
+        next = next + 1 == std::size(activatable) ? 0 : next + 1;
+    }
+}
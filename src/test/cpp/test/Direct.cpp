@@ -0,0 +1,49 @@
+#include "pch.h"
+#include "winrt/Component.Fast.h"
+
+using namespace winrt;
+using namespace Component::Fast;
+
+// The component is generated with -direct, so SlowClass calls its implementation directly when the object was made
+// in this binary, while the same call through the ISlowClass interface always takes the ABI. FastClass, which
+// calls its implementation unconditionally, is the lower bound.
+
+TEST_CASE("Direct")
+{
+    SlowClass c;
+    ISlowClass i = c;
+    REQUIRE(c.First() == L"Slow.First");
+    REQUIRE(c.Second() == L"Slow.Second");
+    REQUIRE(i.First() == L"Slow.First");
+    REQUIRE(i.Second() == L"Slow.Second");
+
+    // Copies of the projected object are still recognized as local.
+    SlowClass copy = i.as<SlowClass>();
+    REQUIRE(copy.First() == L"Slow.First");
+
+    // Methods of other interfaces aren't affected.
+    REQUIRE(c.Third() == L"Slow.Third");
+    REQUIRE(c.NotExclusive() == L"Slow.NotExclusive");
+}
+
+TEST_CASE("Direct benchmark", "[.][benchmark]")
+{
+    SlowClass slow;
+    ISlowClass slow_abi = slow;
+    FastClass fast;
+
+    BENCHMARK("SlowClass through ISlowClass")
+    {
+        slow_abi.First();
+    }
+
+    BENCHMARK("SlowClass direct")
+    {
+        slow.First();
+    }
+
+    BENCHMARK("FastClass")
+    {
+        fast.First();
+    }
+}
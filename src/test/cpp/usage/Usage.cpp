@@ -0,0 +1,48 @@
+#include "pch.h"
+#include "winrt/Component.Fast.h"
+
+using namespace winrt;
+using namespace Component;
+using namespace Component::Fast;
+
+// The projection for this test is generated with -usage usage.txt, which prunes ISlowClass::First from the consuming
+// side. The produce side is left whole, so the object below still implements every method, and a call to Second
+// must still land in the slot after First.
+
+namespace
+{
+    struct Slow : implements<Slow, ISlowClass, INotExclusive>
+    {
+        hstring First()
+        {
+            return L"Usage.First";
+        }
+
+        hstring Second()
+        {
+            return L"Usage.Second";
+        }
+
+        hstring NotExclusive()
+        {
+            return L"Usage.NotExclusive";
+        }
+    };
+
+    template <typename T, typename = std::void_t<>>
+    struct has_first : std::false_type {};
+
+    template <typename T>
+    struct has_first<T, std::void_t<decltype(std::declval<T>().First())>> : std::true_type {};
+}
+
+TEST_CASE("Usage")
+{
+    STATIC_REQUIRE(!has_first<ISlowClass>::value);
+
+    ISlowClass slow = make<Slow>();
+    REQUIRE(slow.Second() == L"Usage.Second");
+
+    INotExclusive not_exclusive = slow.as<INotExclusive>();
+    REQUIRE(not_exclusive.NotExclusive() == L"Usage.NotExclusive");
+}
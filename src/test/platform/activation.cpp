@@ -1,6 +1,5 @@
 #include "pch.h"
 
-// TODO: enable xplat activation test
 #if XLANG_PLATFORM_WINDOWS
 #include "winrt_helpers.h"
 
@@ -26,4 +25,314 @@ TEST_CASE("Simple activation")
     REQUIRE(factory != nullptr);
 }
 
-#endif
\ No newline at end of file
+#else
+#include "test_component.h"
+
+template <typename char_type>
+xlang_result activate(std::basic_string_view<char_type> class_name, void** factory)
+{
+    xlang_string_header str_header{};
+    xlang_string str{};
+    xlang_result result{};
+    if constexpr (std::is_same_v<char_type, char16_t>)
+    {
+        result = xlang_create_string_reference_utf16(class_name.data(), static_cast<uint32_t>(class_name.size()), &str_header, &str);
+    }
+    else
+    {
+        result = xlang_create_string_reference_utf8(class_name.data(), static_cast<uint32_t>(class_name.size()), &str_header, &str);
+    }
+    REQUIRE(result == xlang_error_ok);
+
+    xlang_guid const iid{};
+    result = xlang_get_activation_factory(str, iid, factory);
+    xlang_delete_string(str);
+    return result;
+}
+
+uint32_t factory_value(void* factory) noexcept
+{
+    return static_cast<test_component_factory*>(factory)->value;
+}
+
+uint32_t add_ref_factory(void* factory) noexcept
+{
+    auto typed = static_cast<test_component_factory*>(factory);
+    return typed->vtable->add_ref(typed);
+}
+
+xlang_result invalidate_factories(std::string_view prefix)
+{
+    xlang_string_header str_header{};
+    xlang_string str{};
+    REQUIRE(xlang_create_string_reference_utf8(prefix.data(), static_cast<uint32_t>(prefix.size()), &str_header, &str) == xlang_error_ok);
+    xlang_result const result = xlang_invalidate_activation_factory_cache(str);
+    xlang_delete_string(str);
+    return result;
+}
+
+TEST_CASE("Library activation")
+{
+    // Start every section from a cold factory cache, so lookups actually reach the libraries.
+    REQUIRE(xlang_invalidate_activation_factory_cache(nullptr) == xlang_error_ok);
+    void* factory{};
+
+    SECTION("Missing libraries are reported as unavailable classes")
+    {
+        REQUIRE(xlang_set_activation_search_path("/nonexistent") == xlang_error_ok);
+        REQUIRE(activate(std::string_view{ "PalTest.Nested.Class" }, &factory) == xlang_error_class_not_available);
+        REQUIRE(factory == nullptr);
+    }
+
+    SECTION("Changing the search path retries namespaces that were missing")
+    {
+        REQUIRE(xlang_set_activation_search_path("/nonexistent") == xlang_error_ok);
+        REQUIRE(activate(std::string_view{ "PalTest.Nested.Class" }, &factory) == xlang_error_class_not_available);
+
+        REQUIRE(xlang_set_activation_search_path("/nonexistent:" XLANG_TEST_COMPONENT_DIR) == xlang_error_ok);
+        REQUIRE(activate(std::string_view{ "PalTest.Nested.Class" }, &factory) == xlang_error_ok);
+        REQUIRE(factory_value(factory) == test_component_factory_value);
+        release_factory(factory);
+    }
+
+    SECTION("Repeated activation is served from the resolved library")
+    {
+        REQUIRE(xlang_set_activation_search_path(XLANG_TEST_COMPONENT_DIR) == xlang_error_ok);
+        for (int i = 0; i < 3; ++i)
+        {
+            factory = nullptr;
+            REQUIRE(activate(std::string_view{ "PalTest.Nested.Class" }, &factory) == xlang_error_ok);
+            REQUIRE(factory_value(factory) == test_component_factory_value);
+            release_factory(factory);
+
+            factory = nullptr;
+            REQUIRE(activate(std::u16string_view{ u"PalTest.Nested.Class" }, &factory) == xlang_error_ok);
+            REQUIRE(factory_value(factory) == test_component_factory_value);
+            release_factory(factory);
+        }
+    }
+
+    SECTION("Classes the library does not implement are unavailable")
+    {
+        REQUIRE(xlang_set_activation_search_path(XLANG_TEST_COMPONENT_DIR) == xlang_error_ok);
+        REQUIRE(activate(std::string_view{ "PalTest.Nested.Other" }, &factory) == xlang_error_class_not_available);
+        REQUIRE(activate(std::string_view{ "Unrelated.Class" }, &factory) == xlang_error_class_not_available);
+    }
+
+    REQUIRE(xlang_set_activation_search_path(nullptr) == xlang_error_ok);
+}
+
+TEST_CASE("Activation factory cache")
+{
+    REQUIRE(xlang_set_activation_search_path(XLANG_TEST_COMPONENT_DIR) == xlang_error_ok);
+    REQUIRE(xlang_invalidate_activation_factory_cache(nullptr) == xlang_error_ok);
+
+    xlang_activation_factory_cache_stats before{};
+    REQUIRE(xlang_get_activation_factory_cache_stats(&before) == xlang_error_ok);
+    REQUIRE(before.entries == 0);
+
+    void* first{};
+    void* second{};
+    REQUIRE(activate(std::string_view{ "PalTest.Nested.Class" }, &first) == xlang_error_ok);
+    REQUIRE(activate(std::string_view{ "PalTest.Nested.Class" }, &second) == xlang_error_ok);
+    REQUIRE(first == second);
+
+    xlang_activation_factory_cache_stats after{};
+    REQUIRE(xlang_get_activation_factory_cache_stats(&after) == xlang_error_ok);
+    REQUIRE(after.misses == before.misses + 1);
+    REQUIRE(after.hits == before.hits + 1);
+    REQUIRE(after.entries == 1);
+
+    {
+        INFO("The cache holds one reference, besides the two handed out and the factory's own");
+        REQUIRE(add_ref_factory(first) == 5);
+        REQUIRE(release_factory(first) == 4);
+        release_factory(first);
+        release_factory(second);
+    }
+
+    {
+        INFO("Invalidating an unrelated namespace keeps the entry");
+        REQUIRE(invalidate_factories("PalTest.Nested.Class.Inner") == xlang_error_ok);
+        REQUIRE(invalidate_factories("PalTest.Nest") == xlang_error_ok);
+        REQUIRE(xlang_get_activation_factory_cache_stats(&after) == xlang_error_ok);
+        REQUIRE(after.entries == 1);
+    }
+
+    {
+        INFO("Invalidating the owning namespace releases the cached reference");
+        REQUIRE(invalidate_factories("PalTest") == xlang_error_ok);
+        REQUIRE(xlang_get_activation_factory_cache_stats(&after) == xlang_error_ok);
+        REQUIRE(after.entries == 0);
+        REQUIRE(add_ref_factory(first) == 2);
+        release_factory(first);
+    }
+
+    {
+        INFO("The next activation goes back to the library");
+        REQUIRE(activate(std::u16string_view{ u"PalTest.Nested.Class" }, &first) == xlang_error_ok);
+        xlang_activation_factory_cache_stats reloaded{};
+        REQUIRE(xlang_get_activation_factory_cache_stats(&reloaded) == xlang_error_ok);
+        REQUIRE(reloaded.misses == after.misses + 1);
+        REQUIRE(reloaded.entries == 1);
+        release_factory(first);
+    }
+
+    {
+        INFO("Lookups racing with invalidation keep the factory's references balanced");
+        std::atomic<bool> done{};
+        std::atomic<uint32_t> failures{};
+        std::vector<std::thread> readers;
+        for (int i = 0; i < 4; ++i)
+        {
+            readers.emplace_back([&done, &failures]
+            {
+                while (!done.load())
+                {
+                    void* factory{};
+                    xlang_string str{};
+                    xlang_create_string_utf8("PalTest.Nested.Class", 20, &str);
+                    if (xlang_get_activation_factory(str, xlang_guid{}, &factory) != xlang_error_ok || factory_value(factory) != test_component_factory_value)
+                    {
+                        ++failures;
+                    }
+                    xlang_delete_string(str);
+                    release_factory(factory);
+                }
+            });
+        }
+
+        for (int i = 0; i < 200; ++i)
+        {
+            REQUIRE(invalidate_factories("PalTest") == xlang_error_ok);
+        }
+
+        done = true;
+        for (auto& reader : readers)
+        {
+            reader.join();
+        }
+        REQUIRE(failures == 0);
+
+        REQUIRE(xlang_invalidate_activation_factory_cache(nullptr) == xlang_error_ok);
+        REQUIRE(add_ref_factory(first) == 2);
+        release_factory(first);
+    }
+
+    REQUIRE(xlang_invalidate_activation_factory_cache(nullptr) == xlang_error_ok);
+    REQUIRE(xlang_set_activation_search_path(nullptr) == xlang_error_ok);
+}
+
+namespace
+{
+    // Stands in for a statically linked component, registered during static initialization the way generated
+    // code would be. It implements PalStatic.Widget, and PalTest.Nested.Registered alongside the PalTest library.
+    constexpr uint32_t static_factory_value{ 0x5041'4C32 };
+    std::atomic<uint32_t> static_factory_references{ 1 };
+    std::atomic<uint32_t> static_activation_calls{};
+
+    xlang_result XLANG_CALL static_query_interface(test_component_factory*, xlang_guid const&, void** result) noexcept
+    {
+        *result = nullptr;
+        return xlang_error_class_not_available;
+    }
+
+    uint32_t XLANG_CALL static_add_ref(test_component_factory*) noexcept
+    {
+        return ++static_factory_references;
+    }
+
+    uint32_t XLANG_CALL static_release(test_component_factory*) noexcept
+    {
+        return --static_factory_references;
+    }
+
+    constexpr test_component_factory::vtable_type static_factory_vtable{ static_query_interface, static_add_ref, static_release };
+    test_component_factory static_factory{ &static_factory_vtable, static_factory_value };
+
+    xlang_result XLANG_CALL static_get_activation_factory(xlang_string class_name, xlang_guid const&, void** result) noexcept
+    {
+        ++static_activation_calls;
+        *result = nullptr;
+
+        xlang_char8 const* buffer{};
+        uint32_t length{};
+        // No REQUIRE here: this also runs on the cache tests' reader threads, and Catch isn't thread-safe.
+        xlang_result const error = xlang_get_string_raw_buffer_utf8(class_name, &buffer, &length);
+        if (error != xlang_error_ok)
+        {
+            return error;
+        }
+        std::string_view const name{ reinterpret_cast<char const*>(buffer), length };
+        if (name != "PalStatic.Widget" && name != "PalTest.Nested.Registered")
+        {
+            return xlang_error_class_not_available;
+        }
+
+        static_add_ref(&static_factory);
+        *result = &static_factory;
+        return xlang_error_ok;
+    }
+
+    xlang_result XLANG_CALL failing_get_activation_factory(xlang_string, xlang_guid const&, void** result) noexcept
+    {
+        *result = nullptr;
+        return xlang_error_sadness;
+    }
+
+    xlang_activation_factory_registration const static_registration{ "PalStatic", &static_get_activation_factory };
+    xlang_activation_factory_registration const nested_registration{ "PalTest.Nested", &static_get_activation_factory };
+}
+
+TEST_CASE("Registered activation factories")
+{
+    REQUIRE(static_registration.result == xlang_error_ok);
+    REQUIRE(nested_registration.result == xlang_error_ok);
+    REQUIRE(xlang_invalidate_activation_factory_cache(nullptr) == xlang_error_ok);
+    void* factory{};
+
+    SECTION("Registered classes need no library")
+    {
+        REQUIRE(xlang_set_activation_search_path("/nonexistent") == xlang_error_ok);
+        REQUIRE(activate(std::string_view{ "PalStatic.Widget" }, &factory) == xlang_error_ok);
+        REQUIRE(factory_value(factory) == static_factory_value);
+        release_factory(factory);
+
+        REQUIRE(activate(std::u16string_view{ u"PalStatic.Widget" }, &factory) == xlang_error_ok);
+        REQUIRE(factory_value(factory) == static_factory_value);
+        release_factory(factory);
+
+        REQUIRE(activate(std::string_view{ "PalTest.Nested.Registered" }, &factory) == xlang_error_ok);
+        REQUIRE(factory_value(factory) == static_factory_value);
+        release_factory(factory);
+
+        REQUIRE(activate(std::string_view{ "PalStatic.Other" }, &factory) == xlang_error_class_not_available);
+    }
+
+    SECTION("Classes a registered function doesn't provide fall through to libraries")
+    {
+        REQUIRE(xlang_set_activation_search_path(XLANG_TEST_COMPONENT_DIR) == xlang_error_ok);
+        uint32_t const calls = static_activation_calls;
+        REQUIRE(activate(std::string_view{ "PalTest.Nested.Class" }, &factory) == xlang_error_ok);
+        REQUIRE(factory_value(factory) == test_component_factory_value);
+        REQUIRE(static_activation_calls == calls + 1);
+        release_factory(factory);
+    }
+
+    SECTION("Registration at run time")
+    {
+        REQUIRE(xlang_register_activation_factory("PalFailing.Class", &failing_get_activation_factory) == xlang_error_ok);
+        REQUIRE(activate(std::string_view{ "PalFailing.Class" }, &factory) == xlang_error_sadness);
+        REQUIRE(activate(std::string_view{ "PalFailing.Class2" }, &factory) == xlang_error_class_not_available);
+
+        REQUIRE(xlang_register_activation_factory(nullptr, &failing_get_activation_factory) == xlang_error_pointer);
+        REQUIRE(xlang_register_activation_factory("PalFailing", nullptr) == xlang_error_pointer);
+        REQUIRE(xlang_register_activation_factory("", &failing_get_activation_factory) == xlang_error_invalid_arg);
+        REQUIRE(xlang_register_activation_factory("PalFailing.", &failing_get_activation_factory) == xlang_error_invalid_arg);
+    }
+
+    REQUIRE(xlang_invalidate_activation_factory_cache(nullptr) == xlang_error_ok);
+    REQUIRE(xlang_set_activation_search_path(nullptr) == xlang_error_ok);
+}
+
+#endif
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <pal.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdint.h>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Minimal benchmark harness for the PAL. Each benchmark is a function that does its own setup and then
+// hands the code under test to context::run, which times exactly the requested number of iterations.
+// The driver in main.cpp grows the iteration count until a run lasts long enough to be meaningful.
+
+namespace pal_bench
+{
+    struct context
+    {
+        explicit context(uint64_t iterations) noexcept
+            : iterations_(iterations)
+        {}
+
+        uint64_t iterations() const noexcept
+        {
+            return iterations_;
+        }
+
+        // Bytes of input processed per iteration, used to report throughput.
+        void set_bytes_per_iteration(uint64_t bytes) noexcept
+        {
+            bytes_per_iteration_ = bytes;
+        }
+
+        uint64_t bytes_per_iteration() const noexcept
+        {
+            return bytes_per_iteration_;
+        }
+
+        std::chrono::nanoseconds elapsed() const noexcept
+        {
+            return elapsed_;
+        }
+
+        template <typename body_type>
+        void run(body_type&& body)
+        {
+            auto const start = std::chrono::steady_clock::now();
+            for (uint64_t i = 0; i < iterations_; ++i)
+            {
+                body();
+            }
+            elapsed_ += std::chrono::steady_clock::now() - start;
+        }
+
+        // Calls body(thread_index) the requested number of times on each of thread_count threads, timing
+        // from the moment they are all released until the last one finishes. Thread startup isn't timed.
+        template <typename body_type>
+        void run_concurrent(uint32_t thread_count, body_type&& body)
+        {
+            std::atomic<uint32_t> ready{};
+            std::atomic<bool> go{};
+            std::vector<std::thread> threads;
+            threads.reserve(thread_count);
+            for (uint32_t index = 0; index < thread_count; ++index)
+            {
+                threads.emplace_back([&, index]
+                {
+                    ready.fetch_add(1, std::memory_order_release);
+                    while (!go.load(std::memory_order_acquire))
+                    {
+                        std::this_thread::yield();
+                    }
+                    for (uint64_t i = 0; i < iterations_; ++i)
+                    {
+                        body(index);
+                    }
+                });
+            }
+
+            while (ready.load(std::memory_order_acquire) != thread_count)
+            {
+                std::this_thread::yield();
+            }
+
+            auto const start = std::chrono::steady_clock::now();
+            go.store(true, std::memory_order_release);
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+            elapsed_ += std::chrono::steady_clock::now() - start;
+        }
+
+    private:
+        uint64_t iterations_{};
+        uint64_t bytes_per_iteration_{};
+        std::chrono::nanoseconds elapsed_{};
+    };
+
+    using benchmark_function = void(*)(context&);
+
+    struct benchmark
+    {
+        std::string_view name;
+        benchmark_function function;
+    };
+
+    inline std::vector<benchmark>& registry()
+    {
+        static std::vector<benchmark> benchmarks;
+        return benchmarks;
+    }
+
+    struct registrar
+    {
+        registrar(std::string_view name, benchmark_function function)
+        {
+            registry().push_back({ name, function });
+        }
+    };
+
+    // Keeps the optimizer from discarding results that are otherwise unused.
+    template <typename T>
+    inline void do_not_optimize(T const& value) noexcept
+    {
+#if XLANG_COMPILER_MSVC
+        static_cast<void>(*static_cast<T const volatile*>(&value));
+        _ReadWriteBarrier();
+#else
+        asm volatile("" : : "r,m"(value) : "memory");
+#endif
+    }
+}
+
+#define PAL_BENCH_CONCAT_IMPL(a, b) a##b
+#define PAL_BENCH_CONCAT(a, b) PAL_BENCH_CONCAT_IMPL(a, b)
+
+#define PAL_BENCHMARK(name) \
+    static void PAL_BENCH_CONCAT(pal_benchmark_, __LINE__)(pal_bench::context&); \
+    static pal_bench::registrar PAL_BENCH_CONCAT(pal_benchmark_registrar_, __LINE__){ name, &PAL_BENCH_CONCAT(pal_benchmark_, __LINE__) }; \
+    static void PAL_BENCH_CONCAT(pal_benchmark_, __LINE__)(pal_bench::context& ctx)
@@ -0,0 +1,129 @@
+#include "bench.h"
+
+#include <algorithm>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    constexpr auto min_duration = 200ms;
+    constexpr uint64_t max_iterations = uint64_t{ 1 } << 32;
+
+    struct result
+    {
+        std::string_view name;
+        uint64_t iterations;
+        double ns_per_iteration;
+        uint64_t bytes_per_iteration;
+    };
+
+    result run_benchmark(pal_bench::benchmark const& bench)
+    {
+        uint64_t iterations = 1;
+        for (;;)
+        {
+            pal_bench::context ctx{ iterations };
+            bench.function(ctx);
+
+            if (ctx.elapsed() >= min_duration || iterations >= max_iterations)
+            {
+                double const ns_per_iteration = static_cast<double>(ctx.elapsed().count()) / iterations;
+                printf("%-48.*s %12llu %14.1f", static_cast<int>(bench.name.size()), bench.name.data(),
+                    static_cast<unsigned long long>(iterations), ns_per_iteration);
+                if (ctx.bytes_per_iteration())
+                {
+                    // bytes per nanosecond is GB/s
+                    printf(" %10.2f", ctx.bytes_per_iteration() / ns_per_iteration);
+                }
+                printf("\n");
+                return { bench.name, iterations, ns_per_iteration, ctx.bytes_per_iteration() };
+            }
+
+            // Aim slightly past the minimum duration so the next attempt is usually the last.
+            auto const elapsed = std::max<int64_t>(ctx.elapsed().count(), 1);
+            uint64_t const scaled = static_cast<uint64_t>(iterations * 1.4 * std::chrono::nanoseconds{ min_duration }.count() / elapsed);
+            iterations = std::min(std::max(scaled, iterations * 2), max_iterations);
+        }
+    }
+
+    void write_json_string(FILE* file, std::string_view value)
+    {
+        fputc('"', file);
+        for (char c : value)
+        {
+            if (c == '"' || c == '\\')
+            {
+                fputc('\\', file);
+            }
+            fputc(c, file);
+        }
+        fputc('"', file);
+    }
+
+    // One object per benchmark, in the order they ran, for tools that track results across changes.
+    bool write_json(char const* path, std::vector<result> const& results)
+    {
+        FILE* file = fopen(path, "w");
+        if (!file)
+        {
+            return false;
+        }
+
+        fprintf(file, "{\n  \"string_layout_version\": %u,\n  \"benchmarks\": [", xlang_get_string_layout_version());
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            result const& r = results[i];
+            fprintf(file, "%s\n    { \"name\": ", i == 0 ? "" : ",");
+            write_json_string(file, r.name);
+            fprintf(file, ", \"iterations\": %llu, \"ns_per_iteration\": %.3f", static_cast<unsigned long long>(r.iterations), r.ns_per_iteration);
+            if (r.bytes_per_iteration)
+            {
+                fprintf(file, ", \"bytes_per_iteration\": %llu", static_cast<unsigned long long>(r.bytes_per_iteration));
+            }
+            fprintf(file, " }");
+        }
+        fprintf(file, "\n  ]\n}\n");
+        return fclose(file) == 0;
+    }
+}
+
+// Usage: pal_bench [--json <path>] [name filter]
+// Runs every registered benchmark whose name contains the filter, printing a table and, with --json,
+// also writing the results to path.
+int main(int argc, char** argv)
+{
+    char const* json_path{};
+    std::string_view filter;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view const arg = argv[i];
+        if (arg == "--json" && i + 1 < argc)
+        {
+            json_path = argv[++i];
+        }
+        else
+        {
+            filter = arg;
+        }
+    }
+
+    std::vector<result> results;
+    printf("%-48s %12s %14s %10s\n", "benchmark", "iterations", "ns/iteration", "GB/s");
+    for (auto const& bench : pal_bench::registry())
+    {
+        if (bench.name.find(filter) != std::string_view::npos)
+        {
+            results.push_back(run_benchmark(bench));
+        }
+    }
+
+    if (json_path && !write_json(json_path, results))
+    {
+        fprintf(stderr, "Failed to write %s\n", json_path);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,114 @@
+#include "bench.h"
+
+// Reading a string's characters: in its native encoding, through the exported functions and through the inline
+// accessors in pal.h that read the published header layout, and in the other encoding, both once it has been
+// converted and when it is needed only once.
+
+namespace
+{
+    constexpr std::u16string_view class_name{ u"Windows.Foundation.Uri" };
+
+    struct owned_string
+    {
+        owned_string()
+        {
+            xlang_create_string_utf16(class_name.data(), static_cast<uint32_t>(class_name.size()), &str);
+        }
+
+        ~owned_string()
+        {
+            xlang_delete_string(str);
+        }
+
+        xlang_string str{};
+    };
+}
+
+PAL_BENCHMARK("access/raw_buffer_native/exported")
+{
+    owned_string value;
+    ctx.run([&]
+    {
+        char16_t const* buffer{};
+        uint32_t length{};
+        xlang_get_string_raw_buffer_utf16(value.str, &buffer, &length);
+        pal_bench::do_not_optimize(buffer);
+    });
+}
+
+PAL_BENCHMARK("access/raw_buffer_native/inline")
+{
+    owned_string value;
+    ctx.run([&]
+    {
+        char16_t const* buffer{};
+        uint32_t length{};
+        xlang_get_string_raw_buffer_utf16_inline(value.str, &buffer, &length);
+        pal_bench::do_not_optimize(buffer);
+    });
+}
+
+// The other encoding, once it has been converted and attached to the string
+PAL_BENCHMARK("access/raw_buffer_alternate/exported")
+{
+    owned_string value;
+    ctx.run([&]
+    {
+        xlang_char8 const* buffer{};
+        uint32_t length{};
+        xlang_get_string_raw_buffer_utf8(value.str, &buffer, &length);
+        pal_bench::do_not_optimize(buffer);
+    });
+}
+
+PAL_BENCHMARK("access/encoding/exported")
+{
+    owned_string value;
+    ctx.run([&]
+    {
+        xlang_string_encoding encoding = xlang_get_string_encoding(value.str);
+        pal_bench::do_not_optimize(encoding);
+    });
+}
+
+PAL_BENCHMARK("access/encoding/inline")
+{
+    owned_string value;
+    ctx.run([&]
+    {
+        xlang_string_encoding encoding = xlang_get_string_encoding_inline(value.str);
+        pal_bench::do_not_optimize(encoding);
+    });
+}
+
+// One-shot reads in the other encoding from a fresh string reference: requesting the raw buffer attaches an
+// alternate that is allocated and freed with the reference, while copying converts into a stack buffer.
+PAL_BENCHMARK("access/other_encoding_once/raw_buffer")
+{
+    ctx.run([]
+    {
+        xlang_string_header header;
+        xlang_string value{};
+        xlang_create_string_reference_utf16(class_name.data(), static_cast<uint32_t>(class_name.size()), &header, &value);
+        xlang_char8 const* buffer{};
+        uint32_t length{};
+        xlang_get_string_raw_buffer_utf8(value, &buffer, &length);
+        pal_bench::do_not_optimize(buffer);
+        xlang_delete_string(value);
+    });
+}
+
+PAL_BENCHMARK("access/other_encoding_once/copy_to_stack_buffer")
+{
+    ctx.run([]
+    {
+        xlang_string_header header;
+        xlang_string value{};
+        xlang_create_string_reference_utf16(class_name.data(), static_cast<uint32_t>(class_name.size()), &header, &value);
+        xlang_char8 buffer[128];
+        uint32_t length{};
+        xlang_copy_string_to_buffer_utf8(value, buffer, 128, &length);
+        pal_bench::do_not_optimize(buffer);
+        xlang_delete_string(value);
+    });
+}
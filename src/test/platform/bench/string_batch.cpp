@@ -0,0 +1,86 @@
+#include "bench.h"
+
+#include <string>
+#include <vector>
+
+// Marshaling a 100,000 element string array, one string at a time against xlang_create_strings and
+// xlang_delete_strings. Lengths vary from a few characters to a few dozen, with the occasional string too long
+// to share an arena. ns/iteration covers the whole array.
+
+namespace
+{
+    constexpr uint32_t element_count = 100'000;
+
+    struct string_array
+    {
+        string_array()
+        {
+            constexpr std::u16string_view stem{ u"Windows.ApplicationModel.DataTransfer.StandardDataFormats" };
+            for (uint32_t i = 0; i < element_count; ++i)
+            {
+                std::u16string text{ stem.substr(0, 8 + i % 48) };
+                if (i % 1000 == 0)
+                {
+                    text.append(512, u'x');
+                }
+                for (char16_t c : std::to_string(i))
+                {
+                    text.push_back(c);
+                }
+                texts.push_back(std::move(text));
+            }
+            for (auto const& text : texts)
+            {
+                sources.push_back({ text.data(), static_cast<uint32_t>(text.size()) });
+            }
+            strings.resize(element_count);
+        }
+
+        std::vector<std::u16string> texts;
+        std::vector<xlang_string_source_utf16> sources;
+        std::vector<xlang_string> strings;
+    };
+}
+
+PAL_BENCHMARK("batch/100k_strings/one_at_a_time")
+{
+    string_array array;
+    ctx.run([&]
+    {
+        for (uint32_t i = 0; i < element_count; ++i)
+        {
+            xlang_create_string_utf16(array.sources[i].source_string, array.sources[i].length, &array.strings[i]);
+        }
+        pal_bench::do_not_optimize(array.strings.data());
+        for (uint32_t i = 0; i < element_count; ++i)
+        {
+            xlang_delete_string(array.strings[i]);
+        }
+    });
+}
+
+PAL_BENCHMARK("batch/100k_strings/create_strings")
+{
+    string_array array;
+    ctx.run([&]
+    {
+        xlang_create_strings_utf16(array.sources.data(), element_count, array.strings.data());
+        pal_bench::do_not_optimize(array.strings.data());
+        xlang_delete_strings(array.strings.data(), element_count);
+    });
+}
+
+// Batch creation, but the strings are deleted one by one, as they would be by a caller that hands them out.
+PAL_BENCHMARK("batch/100k_strings/create_strings_delete_individually")
+{
+    string_array array;
+    ctx.run([&]
+    {
+        xlang_create_strings_utf16(array.sources.data(), element_count, array.strings.data());
+        pal_bench::do_not_optimize(array.strings.data());
+        for (uint32_t i = 0; i < element_count; ++i)
+        {
+            xlang_delete_string(array.strings[i]);
+        }
+    });
+}
@@ -0,0 +1,159 @@
+#include "bench.h"
+
+#include <functional>
+#include <string>
+
+// Hashing and ordinal comparison through the PAL, against hashing and comparing the raw UTF-16 buffer the
+// way hosts do without them. Heap strings remember their hash after the first call; references don't have
+// room to, so they show the cost of computing it.
+
+namespace
+{
+    constexpr std::u16string_view class_name{ u"Windows.ApplicationModel.DataTransfer.StandardDataFormats" };
+
+    struct owned_string
+    {
+        explicit owned_string(std::u16string_view value)
+        {
+            xlang_create_string_utf16(value.data(), static_cast<uint32_t>(value.size()), &str);
+        }
+
+        explicit owned_string(std::basic_string_view<xlang_char8> value)
+        {
+            xlang_create_string_utf8(value.data(), static_cast<uint32_t>(value.size()), &str);
+        }
+
+        ~owned_string()
+        {
+            xlang_delete_string(str);
+        }
+
+        xlang_string str{};
+    };
+
+    // A kilobyte of mostly ASCII text, identical in both strings compared, so the whole of it is scanned.
+    std::u16string make_long_text()
+    {
+        std::u16string value;
+        while (value.size() < 1024)
+        {
+            value += u"Windows.Foundation.Collections.IVector\u00e9";
+        }
+        value.resize(1024);
+        return value;
+    }
+
+    std::basic_string<xlang_char8> to_utf8(std::u16string_view value)
+    {
+        owned_string source{ value };
+        xlang_char8 const* buffer{};
+        uint32_t length{};
+        xlang_get_string_raw_buffer_utf8(source.str, &buffer, &length);
+        return { buffer, length };
+    }
+
+    void compare(pal_bench::context& ctx, xlang_string left, xlang_string right, uint64_t bytes)
+    {
+        ctx.set_bytes_per_iteration(bytes);
+        ctx.run([=]
+        {
+            int32_t result{};
+            xlang_compare_string_ordinal(left, right, &result);
+            pal_bench::do_not_optimize(result);
+        });
+    }
+}
+
+PAL_BENCHMARK("hash/heap_string")
+{
+    owned_string value{ class_name };
+    ctx.run([&]
+    {
+        uint32_t hash{};
+        xlang_hash_string(value.str, &hash);
+        pal_bench::do_not_optimize(hash);
+    });
+}
+
+PAL_BENCHMARK("hash/reference/utf8")
+{
+    auto const text = to_utf8(class_name);
+    xlang_string_header header;
+    xlang_string value{};
+    xlang_create_string_reference_utf8(text.c_str(), static_cast<uint32_t>(text.size()), &header, &value);
+    ctx.run([&]
+    {
+        uint32_t hash{};
+        xlang_hash_string(value, &hash);
+        pal_bench::do_not_optimize(hash);
+    });
+}
+
+PAL_BENCHMARK("hash/reference/utf16")
+{
+    xlang_string_header header;
+    xlang_string value{};
+    xlang_create_string_reference_utf16(class_name.data(), static_cast<uint32_t>(class_name.size()), &header, &value);
+    ctx.run([&]
+    {
+        uint32_t hash{};
+        xlang_hash_string(value, &hash);
+        pal_bench::do_not_optimize(hash);
+    });
+}
+
+PAL_BENCHMARK("hash/std_hash_of_raw_buffer")
+{
+    owned_string value{ class_name };
+    ctx.run([&]
+    {
+        char16_t const* buffer{};
+        uint32_t length{};
+        xlang_get_string_raw_buffer_utf16(value.str, &buffer, &length);
+        size_t hash = std::hash<std::u16string_view>{}({ buffer, length });
+        pal_bench::do_not_optimize(hash);
+    });
+}
+
+PAL_BENCHMARK("compare/1KiB/utf16")
+{
+    auto const text = make_long_text();
+    owned_string left{ text };
+    owned_string right{ text };
+    compare(ctx, left.str, right.str, text.size() * sizeof(char16_t));
+}
+
+PAL_BENCHMARK("compare/1KiB/utf8")
+{
+    auto const text = to_utf8(make_long_text());
+    owned_string left{ text };
+    owned_string right{ text };
+    compare(ctx, left.str, right.str, text.size());
+}
+
+PAL_BENCHMARK("compare/1KiB/mixed_encodings")
+{
+    auto const text = make_long_text();
+    owned_string left{ to_utf8(text) };
+    owned_string right{ text };
+    compare(ctx, left.str, right.str, text.size() * sizeof(char16_t));
+}
+
+PAL_BENCHMARK("compare/1KiB/u16string_view_compare")
+{
+    auto const text = make_long_text();
+    owned_string left{ text };
+    owned_string right{ text };
+    ctx.set_bytes_per_iteration(text.size() * sizeof(char16_t));
+    ctx.run([&]
+    {
+        char16_t const* left_buffer{};
+        char16_t const* right_buffer{};
+        uint32_t left_length{};
+        uint32_t right_length{};
+        xlang_get_string_raw_buffer_utf16(left.str, &left_buffer, &left_length);
+        xlang_get_string_raw_buffer_utf16(right.str, &right_buffer, &right_length);
+        int result = std::u16string_view{ left_buffer, left_length }.compare({ right_buffer, right_length });
+        pal_bench::do_not_optimize(result);
+    });
+}
@@ -0,0 +1,106 @@
+#include "bench.h"
+
+#include <string>
+
+// Concatenation through the PAL, against what hosts did before it existed: fetch each part as UTF-16
+// (converting UTF-8 parts into a cached alternate), append it to a std::u16string, then create a new
+// string from the result. The UTF-8 part is a fresh string reference every iteration, so no benchmark
+// gets to reuse an alternate created by an earlier one.
+
+namespace
+{
+    constexpr std::basic_string_view<xlang_char8> namespace_utf8{ u8"Windows.ApplicationModel.DataTransfer" };
+    constexpr std::u16string_view class_utf16{ u"StandardDataFormats" };
+
+    struct parts
+    {
+        parts()
+        {
+            xlang_create_string_utf16(class_utf16.data(), static_cast<uint32_t>(class_utf16.size()), &class_name);
+        }
+
+        ~parts()
+        {
+            xlang_delete_string(class_name);
+        }
+
+        template <typename body_type>
+        void with_values(body_type&& body)
+        {
+            xlang_string_header header;
+            xlang_string namespace_name{};
+            xlang_create_string_reference_utf8(namespace_utf8.data(), static_cast<uint32_t>(namespace_utf8.size()), &header, &namespace_name);
+            xlang_string const values[] = { namespace_name, separator, class_name };
+            body(values);
+            xlang_delete_string(namespace_name);
+        }
+
+        xlang_string_header separator_header;
+        xlang_string separator = [this]
+        {
+            xlang_string result{};
+            xlang_create_string_reference_utf16(u".", 1, &separator_header, &result);
+            return result;
+        }();
+        xlang_string class_name{};
+    };
+}
+
+PAL_BENCHMARK("concat/mixed_encodings/xlang_concat_strings")
+{
+    parts input;
+    ctx.run([&]
+    {
+        input.with_values([](xlang_string const (&values)[3])
+        {
+            xlang_string str{};
+            xlang_concat_strings_utf16(values, 3, &str);
+            pal_bench::do_not_optimize(str);
+            xlang_delete_string(str);
+        });
+    });
+}
+
+PAL_BENCHMARK("concat/mixed_encodings/string_builder")
+{
+    parts input;
+    ctx.run([&]
+    {
+        input.with_values([](xlang_string const (&values)[3])
+        {
+            xlang_string_builder builder{};
+            xlang_create_string_builder_utf16(64, &builder);
+            for (xlang_string value : values)
+            {
+                xlang_string_builder_append_string(builder, value);
+            }
+            xlang_string str{};
+            xlang_promote_string_builder(builder, &str);
+            pal_bench::do_not_optimize(str);
+            xlang_delete_string(str);
+        });
+    });
+}
+
+PAL_BENCHMARK("concat/mixed_encodings/via_std_u16string")
+{
+    parts input;
+    ctx.run([&]
+    {
+        input.with_values([](xlang_string const (&values)[3])
+        {
+            std::u16string result;
+            for (xlang_string value : values)
+            {
+                char16_t const* buffer{};
+                uint32_t length{};
+                xlang_get_string_raw_buffer_utf16(value, &buffer, &length);
+                result.append(buffer, length);
+            }
+            xlang_string str{};
+            xlang_create_string_utf16(result.data(), static_cast<uint32_t>(result.size()), &str);
+            pal_bench::do_not_optimize(str);
+            xlang_delete_string(str);
+        });
+    });
+}
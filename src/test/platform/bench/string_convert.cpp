@@ -0,0 +1,86 @@
+#include "bench.h"
+
+#include <string>
+
+// Throughput of the UTF-8 <-> UTF-16 transcoder behind xlang_get_string_raw_buffer_*. Each iteration
+// wraps the input in a fast-pass string reference, so the timed work is the conversion into a new
+// cache_string alternate plus its allocation and release.
+
+namespace
+{
+    constexpr size_t input_size = 1 << 20;
+
+    template <typename char_type>
+    std::basic_string<char_type> repeat(std::basic_string_view<char_type> pattern)
+    {
+        std::basic_string<char_type> result;
+        result.reserve(input_size / sizeof(char_type) + pattern.size());
+        while (result.size() * sizeof(char_type) < input_size)
+        {
+            result += pattern;
+        }
+        return result;
+    }
+
+    xlang_result get_buffer(xlang_string str, char16_t const** buffer, uint32_t* length) noexcept
+    {
+        return xlang_get_string_raw_buffer_utf16(str, buffer, length);
+    }
+
+    xlang_result get_buffer(xlang_string str, xlang_char8 const** buffer, uint32_t* length) noexcept
+    {
+        return xlang_get_string_raw_buffer_utf8(str, buffer, length);
+    }
+
+    xlang_result create_reference(std::basic_string<xlang_char8> const& value, xlang_string_header* header, xlang_string* str) noexcept
+    {
+        return xlang_create_string_reference_utf8(value.data(), static_cast<uint32_t>(value.size()), header, str);
+    }
+
+    xlang_result create_reference(std::basic_string<char16_t> const& value, xlang_string_header* header, xlang_string* str) noexcept
+    {
+        return xlang_create_string_reference_utf16(value.data(), static_cast<uint32_t>(value.size()), header, str);
+    }
+
+    template <typename char_type, typename other_type>
+    void convert(pal_bench::context& ctx, std::basic_string_view<char_type> pattern)
+    {
+        auto const input = repeat(pattern);
+        ctx.set_bytes_per_iteration(input.size() * sizeof(char_type));
+
+        ctx.run([&]
+        {
+            xlang_string_header header;
+            xlang_string str{};
+            create_reference(input, &header, &str);
+
+            other_type const* buffer{};
+            uint32_t length{};
+            get_buffer(str, &buffer, &length);
+            pal_bench::do_not_optimize(buffer);
+
+            xlang_delete_string(str);
+        });
+    }
+
+    // Representative text shapes, from pure ASCII to supplementary-plane code points
+    constexpr std::basic_string_view<xlang_char8> ascii_utf8{ u8"The quick brown fox jumps over the lazy dog. 0123456789\n" };
+    constexpr std::basic_string_view<xlang_char8> latin_utf8{ u8"Gr\u00f6\u00dfe \u00fcber \u00c4rger, tr\u00e8s fran\u00e7ais. " };
+    constexpr std::basic_string_view<xlang_char8> cjk_utf8{ u8"\u6f22\u5b57\u304b\u306a\u4ea4\u3058\u308a\u6587\u306e\u5909\u63db\u3002" };
+    constexpr std::basic_string_view<xlang_char8> emoji_utf8{ u8"\U0001f600\U0001f680\U0001f30d" };
+
+    constexpr std::basic_string_view<char16_t> ascii_utf16{ u"The quick brown fox jumps over the lazy dog. 0123456789\n" };
+    constexpr std::basic_string_view<char16_t> latin_utf16{ u"Gr\u00f6\u00dfe \u00fcber \u00c4rger, tr\u00e8s fran\u00e7ais. " };
+    constexpr std::basic_string_view<char16_t> cjk_utf16{ u"\u6f22\u5b57\u304b\u306a\u4ea4\u3058\u308a\u6587\u306e\u5909\u63db\u3002" };
+    constexpr std::basic_string_view<char16_t> emoji_utf16{ u"\U0001f600\U0001f680\U0001f30d" };
+}
+
+PAL_BENCHMARK("convert/utf8_to_utf16/ascii") { convert<xlang_char8, char16_t>(ctx, ascii_utf8); }
+PAL_BENCHMARK("convert/utf8_to_utf16/latin") { convert<xlang_char8, char16_t>(ctx, latin_utf8); }
+PAL_BENCHMARK("convert/utf8_to_utf16/cjk") { convert<xlang_char8, char16_t>(ctx, cjk_utf8); }
+PAL_BENCHMARK("convert/utf8_to_utf16/emoji") { convert<xlang_char8, char16_t>(ctx, emoji_utf8); }
+
+PAL_BENCHMARK("convert/utf16_to_utf8/ascii") { convert<char16_t, xlang_char8>(ctx, ascii_utf16); }
+PAL_BENCHMARK("convert/utf16_to_utf8/latin") { convert<char16_t, xlang_char8>(ctx, latin_utf16); }
+PAL_BENCHMARK("convert/utf16_to_utf8/cjk") { convert<char16_t, xlang_char8>(ctx, cjk_utf16); }
+PAL_BENCHMARK("convert/utf16_to_utf8/emoji") { convert<char16_t, xlang_char8>(ctx, emoji_utf16); }
@@ -0,0 +1,317 @@
+#include "bench.h"
+
+#include <algorithm>
+#include <memory>
+
+// Cost of creating and deleting small strings, alone and with several threads allocating at once, and of
+// threads contending for one string's reference count or alternate. In the concurrent benchmarks
+// ns/iteration is wall-clock time per round, where every thread performs one iteration per round.
+
+namespace
+{
+    constexpr std::u16string_view short_value{ u"Windows.Foundation.Uri" };
+    constexpr std::u16string_view medium_value{ u"Windows.ApplicationModel.DataTransfer.StandardDataFormats" };
+
+    xlang_string create(std::u16string_view value) noexcept
+    {
+        xlang_string str{};
+        xlang_create_string_utf16(value.data(), static_cast<uint32_t>(value.size()), &str);
+        return str;
+    }
+
+    void create_delete(pal_bench::context& ctx, uint32_t thread_count, std::u16string_view value)
+    {
+        ctx.run_concurrent(thread_count, [value](uint32_t)
+        {
+            xlang_string str = create(value);
+            pal_bench::do_not_optimize(str);
+            xlang_delete_string(str);
+        });
+    }
+
+    // Each thread keeps a window of live strings, so blocks are recycled out of order rather than
+    // immediately, as they would be by an application holding on to some of what it creates.
+    void create_duplicate_delete(pal_bench::context& ctx, uint32_t thread_count)
+    {
+        constexpr uint32_t window = 64;
+        auto live = std::make_unique<xlang_string[]>(window * thread_count);
+        auto cursors = std::make_unique<uint32_t[]>(thread_count);
+
+        ctx.run_concurrent(thread_count, [&](uint32_t index)
+        {
+            xlang_string* slots = live.get() + index * window;
+            uint32_t& cursor = cursors[index];
+            xlang_string& slot = slots[cursor++ % window];
+            xlang_delete_string(slot);
+
+            xlang_string str = create(medium_value);
+            xlang_duplicate_string(str, &slot);
+            xlang_delete_string(str);
+        });
+
+        for (uint32_t i = 0; i < window * thread_count; ++i)
+        {
+            xlang_delete_string(live[i]);
+        }
+    }
+
+    // With a reference held elsewhere every call finds the existing string; without one, every call creates
+    // the string and every delete removes it from the table again.
+    void create_interned(pal_bench::context& ctx, uint32_t thread_count, bool keep_alive)
+    {
+        xlang_string held{};
+        if (keep_alive)
+        {
+            xlang_create_string_interned_utf16(medium_value.data(), static_cast<uint32_t>(medium_value.size()), &held);
+        }
+
+        ctx.run_concurrent(thread_count, [](uint32_t)
+        {
+            xlang_string str{};
+            xlang_create_string_interned_utf16(medium_value.data(), static_cast<uint32_t>(medium_value.size()), &str);
+            pal_bench::do_not_optimize(str);
+            xlang_delete_string(str);
+        });
+
+        xlang_delete_string(held);
+    }
+
+    // Every thread duplicates and deletes the same string, the pattern for a hot literal shared process-wide.
+    void duplicate_shared(pal_bench::context& ctx, uint32_t thread_count, xlang_string shared)
+    {
+        ctx.run_concurrent(thread_count, [shared](uint32_t)
+        {
+            xlang_string copy{};
+            xlang_duplicate_string(shared, &copy);
+            pal_bench::do_not_optimize(copy);
+            xlang_delete_string(copy);
+        });
+    }
+
+    void duplicate_shared_heap(pal_bench::context& ctx, uint32_t thread_count)
+    {
+        xlang_string shared = create(short_value);
+        duplicate_shared(ctx, thread_count, shared);
+        xlang_delete_string(shared);
+    }
+
+    void duplicate_shared_static(pal_bench::context& ctx, uint32_t thread_count)
+    {
+        static xlang_string_header header;
+        xlang_string shared{};
+        xlang_create_string_static_utf16(short_value.data(), static_cast<uint32_t>(short_value.size()), &header, &shared);
+        duplicate_shared(ctx, thread_count, shared);
+    }
+
+    // A string read in both encodings, with the alternate either attached on first use or created up front.
+    void create_read_both(pal_bench::context& ctx, bool dual)
+    {
+        ctx.run([dual]
+        {
+            xlang_string str{};
+            if (dual)
+            {
+                xlang_create_string_dual_utf16(medium_value.data(), static_cast<uint32_t>(medium_value.size()), &str);
+            }
+            else
+            {
+                str = create(medium_value);
+            }
+
+            char16_t const* utf16{};
+            xlang_char8 const* utf8{};
+            uint32_t length{};
+            xlang_get_string_raw_buffer_utf16(str, &utf16, &length);
+            xlang_get_string_raw_buffer_utf8(str, &utf8, &length);
+            pal_bench::do_not_optimize(utf8);
+            xlang_delete_string(str);
+        });
+    }
+
+    void duplicate_private_heap(pal_bench::context& ctx, uint32_t thread_count)
+    {
+        auto strings = std::make_unique<xlang_string[]>(thread_count);
+        for (uint32_t i = 0; i < thread_count; ++i)
+        {
+            strings[i] = create(short_value);
+        }
+
+        ctx.run_concurrent(thread_count, [&](uint32_t index)
+        {
+            xlang_string copy{};
+            xlang_duplicate_string(strings[index], &copy);
+            pal_bench::do_not_optimize(copy);
+            xlang_delete_string(copy);
+        });
+
+        for (uint32_t i = 0; i < thread_count; ++i)
+        {
+            xlang_delete_string(strings[i]);
+        }
+    }
+
+    void create_reference(pal_bench::context& ctx)
+    {
+        ctx.run([]
+        {
+            xlang_string_header header;
+            xlang_string str{};
+            xlang_create_string_reference_utf16(medium_value.data(), static_cast<uint32_t>(medium_value.size()), &header, &str);
+            pal_bench::do_not_optimize(str);
+            xlang_delete_string(str);
+        });
+    }
+
+    void preallocate_promote(pal_bench::context& ctx)
+    {
+        ctx.run([]
+        {
+            char16_t* chars{};
+            xlang_string_buffer buffer{};
+            xlang_preallocate_string_buffer_utf16(static_cast<uint32_t>(medium_value.size()), &chars, &buffer);
+            std::copy(medium_value.begin(), medium_value.end(), chars);
+            xlang_string str{};
+            xlang_promote_string_buffer(buffer, &str, static_cast<uint32_t>(medium_value.size()));
+            pal_bench::do_not_optimize(str);
+            xlang_delete_string(str);
+        });
+    }
+
+    // Spins, yielding, until every thread has arrived; reusable from one round to the next.
+    struct round_barrier
+    {
+        explicit round_barrier(uint32_t count) noexcept
+            : count_(count)
+        {}
+
+        void arrive_and_wait() noexcept
+        {
+            uint32_t const generation = generation_.load(std::memory_order_acquire);
+            if (arrived_.fetch_add(1, std::memory_order_acq_rel) + 1 == count_)
+            {
+                arrived_.store(0, std::memory_order_relaxed);
+                generation_.store(generation + 1, std::memory_order_release);
+                return;
+            }
+            while (generation_.load(std::memory_order_acquire) == generation)
+            {
+                std::this_thread::yield();
+            }
+        }
+
+    private:
+        uint32_t const count_;
+        std::atomic<uint32_t> arrived_{};
+        std::atomic<uint32_t> generation_{};
+    };
+
+    // Every thread asks for the UTF-8 form of the same new string at once, so they race to attach the alternate
+    // each of them converted, and the losers free theirs. One iteration is one round, barriers included; the
+    // single thread run gives the cost without the race.
+    void alternate_race(pal_bench::context& ctx, uint32_t thread_count)
+    {
+        round_barrier barrier{ thread_count };
+        xlang_string shared{};
+        ctx.run_concurrent(thread_count, [&](uint32_t index)
+        {
+            if (index == 0)
+            {
+                xlang_delete_string(shared);
+                shared = create(medium_value);
+            }
+            barrier.arrive_and_wait();
+
+            xlang_char8 const* buffer{};
+            uint32_t length{};
+            xlang_get_string_raw_buffer_utf8(shared, &buffer, &length);
+            pal_bench::do_not_optimize(buffer);
+            barrier.arrive_and_wait();
+        });
+        xlang_delete_string(shared);
+    }
+
+    // Single producer, single consumer ring of string handles.
+    struct handoff_queue
+    {
+        static constexpr uint32_t capacity = 1024;
+
+        void push(xlang_string str) noexcept
+        {
+            uint32_t const tail = tail_.load(std::memory_order_relaxed);
+            while (tail - head_.load(std::memory_order_acquire) == capacity)
+            {
+                std::this_thread::yield();
+            }
+            slots_[tail % capacity] = str;
+            tail_.store(tail + 1, std::memory_order_release);
+        }
+
+        xlang_string pop() noexcept
+        {
+            uint32_t const head = head_.load(std::memory_order_relaxed);
+            while (tail_.load(std::memory_order_acquire) == head)
+            {
+                std::this_thread::yield();
+            }
+            xlang_string str = slots_[head % capacity];
+            head_.store(head + 1, std::memory_order_release);
+            return str;
+        }
+
+    private:
+        alignas(64) std::atomic<uint32_t> head_{};
+        alignas(64) std::atomic<uint32_t> tail_{};
+        xlang_string slots_[capacity]{};
+    };
+
+    // Even threads create strings and hand them to the next thread, which deletes them, so every block is
+    // freed away from the thread that allocated it.
+    void cross_thread_delete(pal_bench::context& ctx, uint32_t pair_count)
+    {
+        auto queues = std::make_unique<handoff_queue[]>(pair_count);
+
+        ctx.run_concurrent(pair_count * 2, [&](uint32_t index)
+        {
+            handoff_queue& queue = queues[index / 2];
+            if (index % 2 == 0)
+            {
+                queue.push(create(short_value));
+            }
+            else
+            {
+                xlang_delete_string(queue.pop());
+            }
+        });
+    }
+}
+
+PAL_BENCHMARK("lifetime/create_delete/short/1_thread") { create_delete(ctx, 1, short_value); }
+PAL_BENCHMARK("lifetime/create_delete/short/8_threads") { create_delete(ctx, 8, short_value); }
+PAL_BENCHMARK("lifetime/create_delete/medium/1_thread") { create_delete(ctx, 1, medium_value); }
+PAL_BENCHMARK("lifetime/create_delete/medium/8_threads") { create_delete(ctx, 8, medium_value); }
+
+PAL_BENCHMARK("lifetime/create_reference/medium") { create_reference(ctx); }
+PAL_BENCHMARK("lifetime/preallocate_promote/medium") { preallocate_promote(ctx); }
+
+PAL_BENCHMARK("lifetime/create_duplicate_delete/1_thread") { create_duplicate_delete(ctx, 1); }
+PAL_BENCHMARK("lifetime/create_duplicate_delete/8_threads") { create_duplicate_delete(ctx, 8); }
+
+PAL_BENCHMARK("lifetime/create_interned/existing/1_thread") { create_interned(ctx, 1, true); }
+PAL_BENCHMARK("lifetime/create_interned/existing/8_threads") { create_interned(ctx, 8, true); }
+PAL_BENCHMARK("lifetime/create_interned/new/1_thread") { create_interned(ctx, 1, false); }
+
+PAL_BENCHMARK("lifetime/duplicate_shared/heap/1_thread") { duplicate_shared_heap(ctx, 1); }
+PAL_BENCHMARK("lifetime/duplicate_shared/heap/4_threads") { duplicate_shared_heap(ctx, 4); }
+PAL_BENCHMARK("lifetime/duplicate_shared/heap/32_threads") { duplicate_shared_heap(ctx, 32); }
+PAL_BENCHMARK("lifetime/duplicate_private/heap/4_threads") { duplicate_private_heap(ctx, 4); }
+PAL_BENCHMARK("lifetime/duplicate_shared/static/1_thread") { duplicate_shared_static(ctx, 1); }
+PAL_BENCHMARK("lifetime/duplicate_shared/static/32_threads") { duplicate_shared_static(ctx, 32); }
+
+PAL_BENCHMARK("lifetime/create_read_both/alternate_on_demand") { create_read_both(ctx, false); }
+PAL_BENCHMARK("lifetime/create_read_both/dual") { create_read_both(ctx, true); }
+
+PAL_BENCHMARK("lifetime/alternate_race/1_thread") { alternate_race(ctx, 1); }
+PAL_BENCHMARK("lifetime/alternate_race/4_threads") { alternate_race(ctx, 4); }
+
+PAL_BENCHMARK("lifetime/cross_thread_delete/1_pair") { cross_thread_delete(ctx, 1); }
+PAL_BENCHMARK("lifetime/cross_thread_delete/4_pairs") { cross_thread_delete(ctx, 4); }
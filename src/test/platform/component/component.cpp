@@ -0,0 +1,59 @@
+#include <pal.h>
+#include <atomic>
+#include <string_view>
+#include "test_component.h"
+
+// Minimal component used by the activation tests. Loaded as PalTest.so, it implements the class
+// PalTest.Nested.Class, so resolving it exercises the namespace walk past a missing PalTest.Nested.so.
+
+namespace
+{
+    // The factory is a static object that holds one reference to itself, so reference counts observed by
+    // tests are always one higher than the references handed out.
+    std::atomic<uint32_t> reference_count{ 1 };
+
+    xlang_result XLANG_CALL query_interface(test_component_factory*, xlang_guid const&, void** result) noexcept
+    {
+        *result = nullptr;
+        return xlang_error_class_not_available;
+    }
+
+    uint32_t XLANG_CALL add_ref(test_component_factory*) noexcept
+    {
+        return ++reference_count;
+    }
+
+    uint32_t XLANG_CALL release(test_component_factory*) noexcept
+    {
+        return --reference_count;
+    }
+
+    constexpr test_component_factory::vtable_type factory_vtable{ query_interface, add_ref, release };
+    test_component_factory factory{ &factory_vtable, test_component_factory_value };
+}
+
+extern "C" XLANG_EXPORT_DECL xlang_result XLANG_CALL xlang_lib_get_activation_factory(
+    xlang_string class_name,
+    xlang_guid const&,
+    void** result
+) noexcept
+{
+    *result = nullptr;
+
+    xlang_char8 const* buffer{};
+    uint32_t length{};
+    xlang_result const error = xlang_get_string_raw_buffer_utf8(class_name, &buffer, &length);
+    if (error != xlang_error_ok)
+    {
+        return error;
+    }
+
+    if (std::string_view{ reinterpret_cast<char const*>(buffer), length } != "PalTest.Nested.Class")
+    {
+        return xlang_error_class_not_available;
+    }
+
+    add_ref(&factory);
+    *result = &factory;
+    return xlang_error_ok;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <pal.h>
+#include <stdint.h>
+
+// The component's factories are minimal IUnknown objects carrying this value, so tests can recognize them
+// without a type system.
+inline constexpr uint32_t test_component_factory_value{ 0x5041'4C31 };
+
+struct test_component_factory
+{
+    struct vtable_type
+    {
+        xlang_result(XLANG_CALL* query_interface)(test_component_factory*, xlang_guid const&, void**) noexcept;
+        uint32_t(XLANG_CALL* add_ref)(test_component_factory*) noexcept;
+        uint32_t(XLANG_CALL* release)(test_component_factory*) noexcept;
+    };
+
+    vtable_type const* vtable;
+    uint32_t value;
+};
+
+// Releases a factory returned by xlang_get_activation_factory, returning the remaining reference count.
+inline uint32_t release_factory(void* factory) noexcept
+{
+    auto typed = static_cast<test_component_factory*>(factory);
+    return typed->vtable->release(typed);
+}
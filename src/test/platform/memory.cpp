@@ -1,5 +1,45 @@
 #include "pch.h"
 
+namespace
+{
+    // Installed during static initialization, ahead of any PAL allocation, so the whole test run goes through it.
+    struct tracking_allocator
+    {
+        std::atomic<uint64_t> allocs{};
+        std::atomic<uint64_t> frees{};
+        std::atomic<uint64_t> sized_frees{};
+        xlang_result install_result{};
+
+        tracking_allocator() noexcept
+        {
+            install_result = xlang_set_allocator(&vtable);
+        }
+
+        static void* XLANG_CALL alloc(void* context, size_t count)
+        {
+            ++static_cast<tracking_allocator*>(context)->allocs;
+            return ::malloc(count);
+        }
+
+        static void XLANG_CALL free(void* context, void* ptr)
+        {
+            ++static_cast<tracking_allocator*>(context)->frees;
+            ::free(ptr);
+        }
+
+        static void XLANG_CALL sized_free(void* context, void* ptr, size_t)
+        {
+            ++static_cast<tracking_allocator*>(context)->sized_frees;
+            ::free(ptr);
+        }
+
+        // No aligned functions, so the PAL's over-allocating fallback is exercised too.
+        xlang_allocator const vtable{ this, alloc, free, sized_free, nullptr, nullptr };
+    };
+
+    tracking_allocator test_allocator;
+}
+
 struct MemGuard
 {
     MemGuard(void* ptr)
@@ -57,3 +97,112 @@ TEST_CASE("Mem alloc")
         // This will also check xlang_mem_free with null
     }
 }
+
+TEST_CASE("Custom allocator")
+{
+    REQUIRE(test_allocator.install_result == xlang_error_ok);
+
+    SECTION("Memory functions")
+    {
+        auto const allocs = test_allocator.allocs.load();
+        auto const frees = test_allocator.frees.load();
+        {
+            MemGuard ptr{ xlang_mem_alloc(16) };
+            REQUIRE(ptr.m_ptr != nullptr);
+            REQUIRE(test_allocator.allocs == allocs + 1);
+        }
+        REQUIRE(test_allocator.frees == frees + 1);
+    }
+    SECTION("Strings")
+    {
+        // Long enough to be allocated individually rather than from a slab
+        std::u16string const value(1000, u'x');
+        auto const allocs = test_allocator.allocs.load();
+        auto const sized_frees = test_allocator.sized_frees.load();
+
+        xlang_string str{};
+        REQUIRE(xlang_create_string_utf16(value.data(), static_cast<uint32_t>(value.size()), &str) == xlang_error_ok);
+        REQUIRE(test_allocator.allocs == allocs + 1);
+        xlang_delete_string(str);
+        REQUIRE(test_allocator.sized_frees == sized_frees + 1);
+    }
+    SECTION("Replacing the allocator")
+    {
+        xlang_allocator const other{ nullptr, test_allocator.vtable.alloc, test_allocator.vtable.free, nullptr, nullptr, nullptr };
+        REQUIRE(xlang_set_allocator(&other) == xlang_error_illegal_state_change);
+        REQUIRE(xlang_set_allocator(nullptr) == xlang_error_pointer);
+
+        xlang_allocator const incomplete{ nullptr, test_allocator.vtable.alloc, nullptr, nullptr, nullptr, nullptr };
+        REQUIRE(xlang_set_allocator(&incomplete) == xlang_error_invalid_arg);
+    }
+}
+
+TEST_CASE("Diagnostics")
+{
+    auto const snapshot = []
+    {
+        xlang_diagnostics result{};
+        REQUIRE(xlang_get_diagnostics(&result) == xlang_error_ok);
+        REQUIRE(result.high_water_bytes >= result.allocated_bytes - result.freed_bytes);
+        return result;
+    };
+
+    REQUIRE(xlang_get_diagnostics(nullptr) == xlang_error_pointer);
+    xlang_diagnostics const before = snapshot();
+
+    xlang_string heap{};
+    REQUIRE(xlang_create_string_utf16(u"Windows.Foundation.Uri", 22, &heap) == xlang_error_ok);
+    xlang_string_header header;
+    xlang_string reference{};
+    REQUIRE(xlang_create_string_reference_utf16(u"Windows.Foundation.Uri", 22, &header, &reference) == xlang_error_ok);
+
+    xlang_diagnostics const created = snapshot();
+    REQUIRE(created.live_heap_strings == before.live_heap_strings + 1);
+    REQUIRE(created.heap_string_bytes > before.heap_string_bytes);
+    REQUIRE(created.allocation_count == before.allocation_count + 1);
+    REQUIRE(created.allocated_bytes == before.allocated_bytes + (created.heap_string_bytes - before.heap_string_bytes));
+
+    xlang_char8 const* utf8{};
+    uint32_t length{};
+    REQUIRE(xlang_get_string_raw_buffer_utf8(heap, &utf8, &length) == xlang_error_ok);
+    REQUIRE(xlang_get_string_raw_buffer_utf8(reference, &utf8, &length) == xlang_error_ok);
+
+    xlang_diagnostics const converted = snapshot();
+    REQUIRE(converted.live_cache_alternates == before.live_cache_alternates + 1);
+    REQUIRE(converted.live_reference_alternates == before.live_reference_alternates + 1);
+    REQUIRE(converted.cache_alternate_bytes > before.cache_alternate_bytes);
+    REQUIRE(converted.reference_alternate_bytes > before.reference_alternate_bytes);
+
+    // Strings made on another thread, which has exited by the time they are counted and deleted
+    xlang_string batch[8]{};
+    std::thread([&batch]
+    {
+        xlang_string_source_utf16 sources[8];
+        for (auto& source : sources)
+        {
+            source = { u"Windows.Foundation", 18 };
+        }
+        REQUIRE(xlang_create_strings_utf16(sources, 8, batch) == xlang_error_ok);
+    }).join();
+
+    xlang_diagnostics const batched = snapshot();
+    REQUIRE(batched.live_heap_strings == before.live_heap_strings + 9);
+    REQUIRE(batched.allocation_count == before.allocation_count + 4);
+
+    xlang_delete_string(batch[0]);
+    REQUIRE(snapshot().live_heap_strings == before.live_heap_strings + 8);
+    xlang_delete_strings(batch + 1, 7);
+    xlang_delete_string(reference);
+    xlang_delete_string(heap);
+
+    xlang_diagnostics const after = snapshot();
+    REQUIRE(after.live_heap_strings == before.live_heap_strings);
+    REQUIRE(after.live_reference_alternates == before.live_reference_alternates);
+    REQUIRE(after.live_cache_alternates == before.live_cache_alternates);
+    REQUIRE(after.heap_string_bytes == before.heap_string_bytes);
+    REQUIRE(after.reference_alternate_bytes == before.reference_alternate_bytes);
+    REQUIRE(after.cache_alternate_bytes == before.cache_alternate_bytes);
+    REQUIRE(after.free_count == before.free_count + 4);
+    REQUIRE(after.allocated_bytes - after.freed_bytes == before.allocated_bytes - before.freed_bytes);
+    REQUIRE(after.high_water_bytes >= batched.allocated_bytes - batched.freed_bytes);
+}
@@ -5,8 +5,13 @@
 #include <pal.h>
 
 #include <algorithm>
+#include <atomic>
+#include <cstdlib>
 #include <limits>
+#include <string>
 #include <string_view>
+#include <thread>
+#include <vector>
 
 #if XLANG_PLATFORM_WINDOWS
 #include <winrt/base.h>
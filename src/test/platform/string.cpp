@@ -313,6 +313,153 @@ TEST_CASE("Simple UTF-16 string references")
     simple_string_reference<char16_t>();
 }
 
+template <typename char_type>
+void simple_interned_string()
+{
+    for (basic_string_view<char_type> const test_string : valid_strings<char_type>::value)
+    {
+        xlang_string str{};
+        xlang_string same{};
+        xlang_result result{};
+
+        {
+            INFO("Intern the same contents twice");
+            result = xlang_create_string_interned<char_type>(test_string.data(), static_cast<uint32_t>(test_string.size()), &str);
+            REQUIRE(result == xlang_error_ok);
+            basic_string<char_type> const copy{ test_string };
+            result = xlang_create_string_interned<char_type>(copy.data(), static_cast<uint32_t>(copy.size()), &same);
+            REQUIRE(result == xlang_error_ok);
+            REQUIRE(str == same);
+        }
+
+        {
+            INFO("Ensure the buffer contents match the supplied string");
+            char_type const* buffer{};
+            uint32_t length{};
+            result = xlang_get_string_raw_buffer<char_type>(str, &buffer, &length);
+            REQUIRE(result == xlang_error_ok);
+            REQUIRE(basic_string_view<char_type>{buffer, length} == test_string);
+        }
+
+        {
+            INFO("Interned strings are distinct from ordinary ones");
+            xlang_string ordinary{};
+            result = xlang_create_string<char_type>(test_string.data(), static_cast<uint32_t>(test_string.size()), &ordinary);
+            REQUIRE(result == xlang_error_ok);
+            REQUIRE((test_string.empty() || ordinary != str));
+            xlang_delete_string(ordinary);
+        }
+
+        xlang_delete_string(same);
+
+        {
+            INFO("The string stays interned while any reference remains");
+            xlang_string again{};
+            result = xlang_create_string_interned<char_type>(test_string.data(), static_cast<uint32_t>(test_string.size()), &again);
+            REQUIRE(result == xlang_error_ok);
+            REQUIRE(again == str);
+            xlang_delete_string(again);
+        }
+
+        xlang_delete_string(str);
+    }
+
+    {
+        INFO("Null with a nonzero length");
+        xlang_string str{};
+        REQUIRE(xlang_create_string_interned<char_type>(nullptr, 1, &str) == xlang_error_pointer);
+        REQUIRE(str == nullptr);
+    }
+}
+
+TEST_CASE("Simple UTF-8 interned strings")
+{
+    simple_interned_string<xlang_char8>();
+}
+
+TEST_CASE("Simple UTF-16 interned strings")
+{
+    simple_interned_string<char16_t>();
+}
+
+template <typename char_type>
+void simple_static_string()
+{
+    // Static strings must outlive every use, so each gets its own header for the rest of the process.
+    static xlang_string_header headers[std::size(valid_strings<char_type>::value)]{};
+    xlang_string_header* header = headers;
+
+    using other_type = typename alternate_type<char_type>::type;
+
+    for (basic_string_view<char_type> const test_string : valid_strings<char_type>::value)
+    {
+        xlang_string str{};
+        xlang_result result{};
+
+        {
+            INFO("Create a static string");
+            result = xlang_create_string_static<char_type>(test_string.data(), static_cast<uint32_t>(test_string.size()), header++, &str);
+            REQUIRE(result == xlang_error_ok);
+            REQUIRE(has_encoding<char_type>(str));
+        }
+
+        char_type const* buffer{};
+        uint32_t length{};
+        {
+            INFO("Ensure the buffer is the supplied one");
+            result = xlang_get_string_raw_buffer<char_type>(str, &buffer, &length);
+            REQUIRE(result == xlang_error_ok);
+            REQUIRE(basic_string_view<char_type>{buffer, length} == test_string);
+            REQUIRE((test_string.empty() || buffer == test_string.data()));
+        }
+
+        {
+            INFO("Duplicating returns the same handle, and deleting leaves it usable");
+            xlang_string copy{};
+            result = xlang_duplicate_string(str, &copy);
+            REQUIRE(result == xlang_error_ok);
+            REQUIRE(copy == str);
+            xlang_delete_string(copy);
+            xlang_delete_string(str);
+            result = xlang_get_string_raw_buffer<char_type>(str, &buffer, &length);
+            REQUIRE(result == xlang_error_ok);
+            REQUIRE(basic_string_view<char_type>{buffer, length} == test_string);
+        }
+
+        {
+            INFO("The alternate encoding is created once and survives deletes");
+            other_type const* alternate{};
+            other_type const* alternate_again{};
+            uint32_t alternate_length{};
+            result = xlang_get_string_raw_buffer<other_type>(str, &alternate, &alternate_length);
+            REQUIRE(result == xlang_error_ok);
+            xlang_delete_string(str);
+            result = xlang_get_string_raw_buffer<other_type>(str, &alternate_again, &alternate_length);
+            REQUIRE(result == xlang_error_ok);
+            REQUIRE(alternate == alternate_again);
+        }
+    }
+
+    {
+        INFO("Static strings must be null terminated");
+        static constexpr char_type unterminated[] = { 'a', 'b', 'c' };
+        static xlang_string_header unterminated_header{};
+        xlang_string str{};
+        REQUIRE(xlang_create_string_static<char_type>(unterminated, 2, &unterminated_header, &str) == xlang_error_string_not_null_terminated);
+        REQUIRE(str == nullptr);
+    }
+}
+
+TEST_CASE("Simple UTF-8 static strings")
+{
+    simple_static_string<xlang_char8>();
+}
+
+TEST_CASE("Simple UTF-16 static strings")
+{
+    simple_static_string<char16_t>();
+}
+
 template <typename char_type>
 void simple_preallocated()
 {
@@ -502,3 +649,989 @@ TEST_CASE("Convert UTF-16 string reference")
 {
     convert_string_reference<char16_t>();
 }
+
+// Pads each test string with ASCII runs on both sides, so conversions cross the block boundaries of the
+// vectorized transcoder paths rather than only exercising single code points.
+template <typename char_type>
+basic_string<char_type> pad_with_ascii(basic_string_view<char_type> value, size_t padding)
+{
+    basic_string<char_type> result(padding, static_cast<char_type>('x'));
+    result += value;
+    result.append(padding, static_cast<char_type>('y'));
+    return result;
+}
+
+template <typename char_type>
+void convert_padded_string()
+{
+    using other_type = typename alternate_type<char_type>::type;
+    constexpr size_t paddings[] = { 1, 7, 8, 15, 16, 17, 31, 32, 33, 64, 1000 };
+
+    for (size_t const padding : paddings)
+    {
+        for (size_t i = 0; i < std::size(valid_strings<char_type>::value); ++i)
+        {
+            auto const test_string = pad_with_ascii(valid_strings<char_type>::value[i], padding);
+            auto const expected = pad_with_ascii(valid_strings<other_type>::value[i], padding);
+            xlang_result result{};
+            xlang_string str{};
+            {
+                INFO("Create padded string");
+                result = xlang_create_string(test_string.data(), static_cast<uint32_t>(test_string.size()), &str);
+                REQUIRE(result == xlang_error_ok);
+            }
+
+            other_type const* buffer{};
+            uint32_t length{};
+            {
+                INFO("Convert the padded string");
+                result = xlang_get_string_raw_buffer<other_type>(str, &buffer, &length);
+                REQUIRE(result == xlang_error_ok);
+                REQUIRE(basic_string_view<other_type>{ expected } == basic_string_view<other_type>{buffer, length});
+                REQUIRE(buffer[length] == 0);
+            }
+
+            xlang_delete_string(str);
+        }
+
+        for (auto const& invalid_string : invalid_strings<char_type>::value)
+        {
+            auto const test_string = pad_with_ascii(invalid_string, padding);
+            xlang_result result{};
+            xlang_string str{};
+            {
+                INFO("Create padded string");
+                result = xlang_create_string(test_string.data(), static_cast<uint32_t>(test_string.size()), &str);
+                REQUIRE(result == xlang_error_ok);
+            }
+
+            other_type const* buffer{};
+            uint32_t length{};
+            {
+                INFO("Fail to convert padded string");
+                result = xlang_get_string_raw_buffer<other_type>(str, &buffer, &length);
+                REQUIRE(result == xlang_error_untranslatable_string);
+                REQUIRE(buffer == nullptr);
+                REQUIRE(length == 0);
+            }
+
+            xlang_delete_string(str);
+        }
+    }
+}
+
+TEST_CASE("Convert padded UTF-8 string")
+{
+    convert_padded_string<xlang_char8>();
+}
+
+TEST_CASE("Convert padded UTF-16 string")
+{
+    convert_padded_string<char16_t>();
+}
+
+namespace
+{
+    // Lengths either side of the allocator's size classes, up to strings that are allocated individually.
+    std::vector<std::u16string> make_test_strings(uint32_t count)
+    {
+        std::vector<std::u16string> result;
+        result.reserve(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            result.emplace_back(1 + i % 300, static_cast<char16_t>(u'a' + i % 26));
+        }
+        return result;
+    }
+
+    void check_string(xlang_string str, std::u16string const& expected)
+    {
+        char16_t const* buffer{};
+        uint32_t length{};
+        REQUIRE(xlang_get_string_raw_buffer_utf16(str, &buffer, &length) == xlang_error_ok);
+        REQUIRE(std::u16string_view{ buffer, length } == expected);
+
+        xlang_char8 const* alternate{};
+        REQUIRE(xlang_get_string_raw_buffer_utf8(str, &alternate, &length) == xlang_error_ok);
+        REQUIRE(length == expected.size());
+    }
+}
+
+TEST_CASE("Strings deleted on other threads")
+{
+    constexpr uint32_t thread_count = 4;
+    constexpr uint32_t count = 2000;
+    auto const values = make_test_strings(count);
+
+    std::vector<xlang_string> strings(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        REQUIRE(xlang_create_string_utf16(values[i].data(), static_cast<uint32_t>(values[i].size()), &strings[i]) == xlang_error_ok);
+    }
+
+    // Each thread frees an interleaved share, so every slab receives frees from several threads.
+    std::atomic<uint32_t> mismatches{};
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([&, t]
+        {
+            for (uint32_t i = t; i < count; i += thread_count)
+            {
+                char16_t const* buffer{};
+                uint32_t length{};
+                if (xlang_get_string_raw_buffer_utf16(strings[i], &buffer, &length) != xlang_error_ok
+                    || std::u16string_view{ buffer, length } != values[i])
+                {
+                    ++mismatches;
+                }
+                xlang_delete_string(strings[i]);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    REQUIRE(mismatches == 0);
+
+    // The main thread reuses the freed blocks.
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        REQUIRE(xlang_create_string_utf16(values[i].data(), static_cast<uint32_t>(values[i].size()), &strings[i]) == xlang_error_ok);
+    }
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        check_string(strings[i], values[i]);
+        xlang_delete_string(strings[i]);
+    }
+}
+
+TEST_CASE("Strings outlive the thread that created them")
+{
+    constexpr uint32_t count = 2000;
+    auto const values = make_test_strings(count);
+
+    std::vector<xlang_string> strings(count);
+    std::thread creator{ [&]
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            xlang_create_string_utf16(values[i].data(), static_cast<uint32_t>(values[i].size()), &strings[i]);
+        }
+    } };
+    creator.join();
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        REQUIRE(strings[i] != nullptr);
+        check_string(strings[i], values[i]);
+
+        xlang_string copy{};
+        REQUIRE(xlang_duplicate_string(strings[i], &copy) == xlang_error_ok);
+        xlang_delete_string(strings[i]);
+        check_string(copy, values[i]);
+        xlang_delete_string(copy);
+    }
+}
+
+TEST_CASE("Interned strings across threads")
+{
+    constexpr uint32_t thread_count = 4;
+    constexpr uint32_t rounds = 200;
+    auto const values = make_test_strings(64);
+
+    // Threads repeatedly intern and release the same names, so entries are constantly removed and recreated
+    // while other threads look them up. Whatever a thread gets back must have the requested contents, and
+    // everything it holds at once for the same name must be one string.
+    std::atomic<uint32_t> failures{};
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([&]
+        {
+            for (uint32_t round = 0; round < rounds; ++round)
+            {
+                for (auto const& value : values)
+                {
+                    xlang_string first{};
+                    xlang_string second{};
+                    xlang_create_string_interned_utf16(value.data(), static_cast<uint32_t>(value.size()), &first);
+                    xlang_create_string_interned_utf16(value.data(), static_cast<uint32_t>(value.size()), &second);
+
+                    char16_t const* buffer{};
+                    uint32_t length{};
+                    xlang_get_string_raw_buffer_utf16(first, &buffer, &length);
+                    if (first != second || std::u16string_view{ buffer, length } != value)
+                    {
+                        ++failures;
+                    }
+                    xlang_delete_string(first);
+                    xlang_delete_string(second);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    REQUIRE(failures == 0);
+}
+
+namespace
+{
+    xlang_string make_utf8(std::basic_string_view<xlang_char8> value)
+    {
+        xlang_string str{};
+        REQUIRE(xlang_create_string_utf8(value.data(), static_cast<uint32_t>(value.size()), &str) == xlang_error_ok);
+        return str;
+    }
+
+    xlang_string make_utf16(std::u16string_view value)
+    {
+        xlang_string str{};
+        REQUIRE(xlang_create_string_utf16(value.data(), static_cast<uint32_t>(value.size()), &str) == xlang_error_ok);
+        return str;
+    }
+
+    template <typename char_type>
+    basic_string_view<char_type> get_view(xlang_string str)
+    {
+        char_type const* buffer{};
+        uint32_t length{};
+        REQUIRE(xlang_get_string_raw_buffer<char_type>(str, &buffer, &length) == xlang_error_ok);
+        REQUIRE(buffer[length] == 0);
+        return { buffer, length };
+    }
+}
+
+TEST_CASE("String concatenation")
+{
+    xlang_string_header header;
+    xlang_string reference{};
+    REQUIRE(xlang_create_string_reference_utf16(u"\u00e9t\u00e9", 3, &header, &reference) == xlang_error_ok);
+
+    xlang_string const parts[] = {
+        make_utf8(u8"Windows."),
+        nullptr,
+        make_utf16(u"Foundation"),
+        reference,
+        make_utf8(u8".\U0001f600"),
+    };
+
+    SECTION("UTF-8 result")
+    {
+        xlang_string str{};
+        REQUIRE(xlang_concat_strings_utf8(parts, static_cast<uint32_t>(std::size(parts)), &str) == xlang_error_ok);
+        REQUIRE(xlang_get_string_encoding(str) == xlang_string_encoding::utf8);
+        REQUIRE(get_view<xlang_char8>(str) == u8"Windows.Foundation\u00e9t\u00e9.\U0001f600"sv);
+        xlang_delete_string(str);
+    }
+    SECTION("UTF-16 result")
+    {
+        xlang_string str{};
+        REQUIRE(xlang_concat_strings_utf16(parts, static_cast<uint32_t>(std::size(parts)), &str) == xlang_error_ok);
+        REQUIRE(xlang_get_string_encoding(str) == xlang_string_encoding::utf16);
+        REQUIRE(get_view<char16_t>(str) == u"Windows.Foundation\u00e9t\u00e9.\U0001f600"sv);
+        xlang_delete_string(str);
+    }
+    SECTION("Nothing to concatenate")
+    {
+        xlang_string str = parts[0];
+        REQUIRE(xlang_concat_strings_utf8(nullptr, 0, &str) == xlang_error_ok);
+        REQUIRE(str == nullptr);
+        REQUIRE(xlang_concat_strings_utf16(parts + 1, 1, &str) == xlang_error_ok);
+        REQUIRE(str == nullptr);
+        REQUIRE(xlang_concat_strings_utf16(nullptr, 1, &str) == xlang_error_pointer);
+    }
+    SECTION("A single string")
+    {
+        xlang_string str{};
+        REQUIRE(xlang_concat_strings_utf8(parts, 2, &str) == xlang_error_ok);
+        REQUIRE(get_view<xlang_char8>(str) == u8"Windows."sv);
+        xlang_delete_string(str);
+        REQUIRE(xlang_concat_strings_utf8(parts + 3, 1, &str) == xlang_error_ok);
+        REQUIRE(get_view<xlang_char8>(str) == u8"\u00e9t\u00e9"sv);
+        xlang_delete_string(str);
+    }
+    SECTION("Invalid input")
+    {
+        xlang_string const invalid[] = { parts[0], make_utf16(u"\xd800"sv) };
+        xlang_string str = parts[0];
+        REQUIRE(xlang_concat_strings_utf8(invalid, 2, &str) == xlang_error_untranslatable_string);
+        REQUIRE(str == nullptr);
+        xlang_delete_string(invalid[1]);
+    }
+
+    for (xlang_string part : parts)
+    {
+        xlang_delete_string(part);
+    }
+}
+
+TEST_CASE("String builder")
+{
+    SECTION("Appending grows the buffer")
+    {
+        xlang_string_builder builder{};
+        REQUIRE(xlang_create_string_builder_utf16(4, &builder) == xlang_error_ok);
+
+        std::u16string expected;
+        for (uint32_t i = 0; i < 100; ++i)
+        {
+            REQUIRE(xlang_string_builder_append_utf16(builder, u"abc", 3) == xlang_error_ok);
+            REQUIRE(xlang_string_builder_append_utf8(builder, u8"\u00e9\U0001f600", 6) == xlang_error_ok);
+            expected += u"abc\u00e9\U0001f600";
+        }
+
+        xlang_string part = make_utf8(u8"-end");
+        REQUIRE(xlang_string_builder_append_string(builder, part) == xlang_error_ok);
+        REQUIRE(xlang_string_builder_append_string(builder, nullptr) == xlang_error_ok);
+        xlang_delete_string(part);
+        expected += u"-end";
+
+        xlang_string str{};
+        REQUIRE(xlang_promote_string_builder(builder, &str) == xlang_error_ok);
+        REQUIRE(get_view<char16_t>(str) == expected);
+        REQUIRE(xlang_get_string_encoding(str) == xlang_string_encoding::utf16);
+
+        xlang_string copy{};
+        REQUIRE(xlang_duplicate_string(str, &copy) == xlang_error_ok);
+        REQUIRE(copy == str);
+        xlang_delete_string(copy);
+        xlang_delete_string(str);
+    }
+    SECTION("Invalid input leaves the builder unchanged")
+    {
+        xlang_string_builder builder{};
+        REQUIRE(xlang_create_string_builder_utf8(0, &builder) == xlang_error_ok);
+        REQUIRE(xlang_string_builder_append_utf8(builder, u8"ok", 2) == xlang_error_ok);
+        REQUIRE(xlang_string_builder_append_utf16(builder, u"x\xdc00", 2) == xlang_error_untranslatable_string);
+        REQUIRE(xlang_string_builder_append_utf8(builder, nullptr, 1) == xlang_error_pointer);
+
+        xlang_string str{};
+        REQUIRE(xlang_promote_string_builder(builder, &str) == xlang_error_ok);
+        REQUIRE(get_view<xlang_char8>(str) == u8"ok"sv);
+        xlang_delete_string(str);
+    }
+    SECTION("Empty builders")
+    {
+        xlang_string_builder builder{};
+        REQUIRE(xlang_create_string_builder_utf8(32, &builder) == xlang_error_ok);
+        xlang_string str{};
+        REQUIRE(xlang_promote_string_builder(builder, &str) == xlang_error_ok);
+        REQUIRE(str == nullptr);
+
+        REQUIRE(xlang_create_string_builder_utf16(32, &builder) == xlang_error_ok);
+        REQUIRE(xlang_string_builder_append_utf16(builder, u"discarded", 9) == xlang_error_ok);
+        REQUIRE(xlang_delete_string_builder(builder) == xlang_error_ok);
+        REQUIRE(xlang_delete_string_builder(nullptr) == xlang_error_pointer);
+    }
+}
+
+namespace
+{
+    uint32_t get_hash(xlang_string str)
+    {
+        uint32_t hash{};
+        REQUIRE(xlang_hash_string(str, &hash) == xlang_error_ok);
+        return hash;
+    }
+
+    int32_t compare_ordinal(xlang_string left, xlang_string right)
+    {
+        int32_t result{};
+        REQUIRE(xlang_compare_string_ordinal(left, right, &result) == xlang_error_ok);
+        return result;
+    }
+
+    // Long enough to be hashed and compared in several pieces, with a surrogate pair straddling the first
+    // boundary in UTF-16 and a multi-byte sequence straddling it in UTF-8.
+    std::u16string make_long_text()
+    {
+        std::u16string value(127, u'a');
+        value += u"\U0001f600";
+        value += std::u16string(126, u'b');
+        value += u"\u00e9";
+        for (uint32_t i = 0; i < 200; ++i)
+        {
+            value += u"xyz\u4e2d";
+        }
+        return value;
+    }
+
+    std::basic_string<xlang_char8> to_utf8(std::u16string_view value)
+    {
+        xlang_string str = make_utf16(value);
+        auto result = std::basic_string<xlang_char8>{ get_view<xlang_char8>(str) };
+        xlang_delete_string(str);
+        return result;
+    }
+}
+
+namespace
+{
+    void append_utf8(std::basic_string<xlang_char8>& result, char32_t c)
+    {
+        auto const push = [&](uint32_t byte) { result.push_back(static_cast<xlang_char8>(byte)); };
+        if (c < 0x80)
+        {
+            push(c);
+        }
+        else if (c < 0x800)
+        {
+            push(0xC0 | (c >> 6));
+            push(0x80 | (c & 0x3F));
+        }
+        else if (c < 0x10000)
+        {
+            push(0xE0 | (c >> 12));
+            push(0x80 | ((c >> 6) & 0x3F));
+            push(0x80 | (c & 0x3F));
+        }
+        else
+        {
+            push(0xF0 | (c >> 18));
+            push(0x80 | ((c >> 12) & 0x3F));
+            push(0x80 | ((c >> 6) & 0x3F));
+            push(0x80 | (c & 0x3F));
+        }
+    }
+
+    void append_utf16(std::u16string& result, char32_t c)
+    {
+        if (c < 0x10000)
+        {
+            result.push_back(static_cast<char16_t>(c));
+        }
+        else
+        {
+            result.push_back(static_cast<char16_t>(0xD800 + ((c - 0x10000) >> 10)));
+            result.push_back(static_cast<char16_t>(0xDC00 + ((c - 0x10000) & 0x3FF)));
+        }
+    }
+
+    template <typename char_type>
+    void check_conversion(basic_string_view<char_type> value, basic_string_view<typename alternate_type<char_type>::type> expected)
+    {
+        xlang_string str{};
+        REQUIRE(xlang_create_string(value.data(), static_cast<uint32_t>(value.size()), &str) == xlang_error_ok);
+        REQUIRE(get_view<typename alternate_type<char_type>::type>(str) == expected);
+        xlang_delete_string(str);
+    }
+}
+
+// Long runs of each UTF-8 sequence length, alone and mixed, so every vector kernel is entered and left at every
+// block offset.
+TEST_CASE("Convert multi-byte runs")
+{
+    constexpr char32_t samples[][4] = {
+        { U'a', U'~', U'0', U'\x7f' },
+        { U'\u00e9', U'\u0416', U'\u0080', U'\u07ff' },
+        { U'\u4e2d', U'\u0800', U'\ud7ff', U'\uffff' },
+        { U'\U0001f600', U'\U00010000', U'\U0010ffff', U'\U0001d11e' },
+    };
+
+    // Each mix is a bit mask of the sequence lengths it draws from.
+    for (uint32_t mix = 1; mix < 16; ++mix)
+    {
+        uint32_t seed = mix;
+        for (uint32_t count : { 1u, 7u, 8u, 9u, 15u, 16u, 17u, 31u, 33u, 100u, 300u })
+        {
+            std::basic_string<xlang_char8> utf8;
+            std::u16string utf16;
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                seed = seed * 1103515245 + 12345;
+                uint32_t kind = (seed >> 16) % 4;
+                while (!(mix & (1 << kind)))
+                {
+                    kind = (kind + 1) % 4;
+                }
+                char32_t const c = samples[kind][(seed >> 8) % 4];
+                append_utf8(utf8, c);
+                append_utf16(utf16, c);
+            }
+
+            INFO("mix " << mix << ", " << count << " code points");
+            check_conversion<xlang_char8>(utf8, utf16);
+            check_conversion<char16_t>(utf16, utf8);
+        }
+    }
+
+    SECTION("Malformed sequences inside two byte runs")
+    {
+        std::basic_string<xlang_char8> run;
+        for (uint32_t i = 0; i < 40; ++i)
+        {
+            append_utf8(run, U'\u00e9');
+        }
+
+        for (size_t position = 0; position < run.size(); ++position)
+        {
+            for (uint8_t replacement : { 0x80, 0xC1, 0x41, 0xE0 })
+            {
+                auto value = run;
+                value[position] = static_cast<xlang_char8>(replacement);
+                if (replacement == 0x80 && position % 2 == 1)
+                {
+                    // Another continuation byte in place of a continuation byte is still well formed.
+                    continue;
+                }
+
+                INFO("byte " << static_cast<uint32_t>(replacement) << " at " << position);
+                xlang_string str{};
+                REQUIRE(xlang_create_string(value.data(), static_cast<uint32_t>(value.size()), &str) == xlang_error_ok);
+                char16_t const* buffer{};
+                uint32_t length{};
+                REQUIRE(xlang_get_string_raw_buffer_utf16(str, &buffer, &length) == xlang_error_untranslatable_string);
+                xlang_delete_string(str);
+            }
+        }
+
+        // A run cut off in the middle of its last sequence
+        run.pop_back();
+        xlang_string str{};
+        REQUIRE(xlang_create_string(run.data(), static_cast<uint32_t>(run.size()), &str) == xlang_error_ok);
+        char16_t const* buffer{};
+        uint32_t length{};
+        REQUIRE(xlang_get_string_raw_buffer_utf16(str, &buffer, &length) == xlang_error_untranslatable_string);
+        xlang_delete_string(str);
+    }
+}
+
+TEST_CASE("String hashing")
+{
+    SECTION("Equal text hashes equally in every encoding and kind of string")
+    {
+        xlang_string utf8 = make_utf8(u8"Windows.Foundation.Uri\u00e9\U0001f600");
+        xlang_string utf16 = make_utf16(u"Windows.Foundation.Uri\u00e9\U0001f600");
+        uint32_t const expected = get_hash(utf8);
+        REQUIRE(get_hash(utf16) == expected);
+        REQUIRE(get_hash(utf8) == expected);
+
+        xlang_string_header header;
+        xlang_string reference{};
+        REQUIRE(xlang_create_string_reference_utf16(u"Windows.Foundation.Uri\u00e9\U0001f600", 25, &header, &reference) == xlang_error_ok);
+        REQUIRE(get_hash(reference) == expected);
+
+        static xlang_string_header static_header;
+        xlang_string static_str{};
+        REQUIRE(xlang_create_string_static_utf8(u8"Windows.Foundation.Uri\u00e9\U0001f600", 28, &static_header, &static_str) == xlang_error_ok);
+        REQUIRE(get_hash(static_str) == expected);
+
+        // Once an alternate exists it is hashed instead, with the same result.
+        xlang_string other = make_utf16(u"Windows.Foundation.Uri\u00e9\U0001f600");
+        xlang_char8 const* buffer{};
+        uint32_t length{};
+        REQUIRE(xlang_get_string_raw_buffer_utf8(other, &buffer, &length) == xlang_error_ok);
+        REQUIRE(get_hash(other) == expected);
+
+        xlang_delete_string(other);
+        xlang_delete_string(utf16);
+        xlang_delete_string(utf8);
+    }
+    SECTION("Long strings")
+    {
+        std::u16string const text = make_long_text();
+        std::basic_string<xlang_char8> const text_utf8 = to_utf8(text);
+        xlang_string utf16 = make_utf16(text);
+        xlang_string utf8 = make_utf8(text_utf8);
+        REQUIRE(get_hash(utf16) == get_hash(utf8));
+
+        xlang_string shorter = make_utf16(std::u16string_view{ text }.substr(0, text.size() - 1));
+        REQUIRE(get_hash(shorter) != get_hash(utf16));
+
+        xlang_delete_string(shorter);
+        xlang_delete_string(utf8);
+        xlang_delete_string(utf16);
+    }
+    SECTION("Different text")
+    {
+        std::u16string_view const values[] = { u"a", u"b", u"ab", u"ba", u"aaaaaaaa", u"aaaaaaaaa", u"Windows.Foundation.Uri", u"Windows.Foundation.Url" };
+        std::vector<uint32_t> hashes;
+        for (auto value : values)
+        {
+            xlang_string str = make_utf16(value);
+            hashes.push_back(get_hash(str));
+            xlang_delete_string(str);
+        }
+        std::sort(hashes.begin(), hashes.end());
+        REQUIRE(std::adjacent_find(hashes.begin(), hashes.end()) == hashes.end());
+    }
+    SECTION("Errors")
+    {
+        REQUIRE(get_hash(nullptr) == get_hash(nullptr));
+        REQUIRE(xlang_hash_string(nullptr, nullptr) == xlang_error_pointer);
+
+        xlang_string invalid = make_utf16(u"\xd800"sv);
+        uint32_t hash{};
+        REQUIRE(xlang_hash_string(invalid, &hash) == xlang_error_untranslatable_string);
+        xlang_delete_string(invalid);
+    }
+}
+
+TEST_CASE("Ordinal string comparison")
+{
+    SECTION("Code point order in every combination of encodings")
+    {
+        // U+FF21 sorts after the surrogate pair's code units in UTF-16, but before U+1F600 by code point.
+        std::u16string_view const ordered[] = { u"A", u"AB", u"B", u"a", u"\u00e9", u"\uff21", u"\U0001f600", u"\U0001f600a" };
+
+        std::vector<xlang_string> utf8;
+        std::vector<xlang_string> utf16;
+        for (auto value : ordered)
+        {
+            utf8.push_back(make_utf8(to_utf8(value)));
+            utf16.push_back(make_utf16(value));
+        }
+
+        for (size_t i = 0; i < std::size(ordered); ++i)
+        {
+            for (size_t j = 0; j < std::size(ordered); ++j)
+            {
+                int32_t const expected = i < j ? -1 : i > j ? 1 : 0;
+                for (auto left : { utf8[i], utf16[i] })
+                {
+                    for (auto right : { utf8[j], utf16[j] })
+                    {
+                        REQUIRE(compare_ordinal(left, right) == expected);
+                    }
+                }
+            }
+            REQUIRE(compare_ordinal(nullptr, utf8[i]) < 0);
+            REQUIRE(compare_ordinal(utf16[i], nullptr) > 0);
+        }
+
+        for (size_t i = 0; i < std::size(ordered); ++i)
+        {
+            xlang_delete_string(utf8[i]);
+            xlang_delete_string(utf16[i]);
+        }
+    }
+    SECTION("Long strings")
+    {
+        std::u16string const text = make_long_text();
+        std::u16string changed = text;
+        changed[changed.size() - 2] = u'\uffff';
+
+        xlang_string utf16 = make_utf16(text);
+        xlang_string utf8 = make_utf8(to_utf8(text));
+        xlang_string changed_utf16 = make_utf16(changed);
+        xlang_string changed_utf8 = make_utf8(to_utf8(changed));
+        xlang_string prefix_utf8 = make_utf8(to_utf8(std::u16string_view{ text }.substr(0, 300)));
+
+        REQUIRE(compare_ordinal(utf8, utf16) == 0);
+        REQUIRE(compare_ordinal(utf16, utf8) == 0);
+        REQUIRE(compare_ordinal(utf8, changed_utf16) < 0);
+        REQUIRE(compare_ordinal(changed_utf8, utf16) > 0);
+        REQUIRE(compare_ordinal(changed_utf16, utf16) > 0);
+        REQUIRE(compare_ordinal(prefix_utf8, utf16) < 0);
+        REQUIRE(compare_ordinal(utf16, prefix_utf8) > 0);
+
+        // Comparing doesn't attach alternates
+        REQUIRE(xlang_get_string_encoding(utf8) == xlang_string_encoding::utf8);
+        REQUIRE(xlang_get_string_encoding(utf16) == xlang_string_encoding::utf16);
+
+        xlang_delete_string(prefix_utf8);
+        xlang_delete_string(changed_utf8);
+        xlang_delete_string(changed_utf16);
+        xlang_delete_string(utf8);
+        xlang_delete_string(utf16);
+    }
+    SECTION("Errors")
+    {
+        REQUIRE(compare_ordinal(nullptr, nullptr) == 0);
+        REQUIRE(xlang_compare_string_ordinal(nullptr, nullptr, nullptr) == xlang_error_pointer);
+
+        // Only text that has to be converted is validated
+        xlang_string valid = make_utf16(u"abc");
+        xlang_string invalid = make_utf8(u8"ab\xc0"sv);
+        int32_t result{};
+        REQUIRE(xlang_compare_string_ordinal(valid, invalid, &result) == xlang_error_untranslatable_string);
+        xlang_delete_string(invalid);
+        xlang_delete_string(valid);
+    }
+}
+
+TEST_CASE("Dual-encoded strings")
+{
+    SECTION("Both encodings are available without conversion")
+    {
+        xlang_string from_utf8{};
+        REQUIRE(xlang_create_string_dual_utf8(u8"Uri\u00e9\U0001f600", 9, &from_utf8) == xlang_error_ok);
+        xlang_string from_utf16{};
+        REQUIRE(xlang_create_string_dual_utf16(u"Uri\u00e9\U0001f600", 6, &from_utf16) == xlang_error_ok);
+
+        for (xlang_string str : { from_utf8, from_utf16 })
+        {
+            REQUIRE(xlang_get_string_encoding(str) == (xlang_string_encoding::utf8 | xlang_string_encoding::utf16));
+            REQUIRE(get_view<xlang_char8>(str) == u8"Uri\u00e9\U0001f600"sv);
+            REQUIRE(get_view<char16_t>(str) == u"Uri\u00e9\U0001f600"sv);
+
+            xlang_char8 const* utf8{};
+            char16_t const* utf16{};
+            uint32_t length{};
+            REQUIRE(xlang_get_string_raw_buffer_utf8(str, &utf8, &length) == xlang_error_ok);
+            REQUIRE(utf8[length] == 0);
+            REQUIRE(xlang_get_string_raw_buffer_utf16(str, &utf16, &length) == xlang_error_ok);
+            REQUIRE(utf16[length] == 0);
+
+            xlang_string copy{};
+            REQUIRE(xlang_duplicate_string(str, &copy) == xlang_error_ok);
+            REQUIRE(copy == str);
+            xlang_delete_string(copy);
+        }
+
+        xlang_delete_string(from_utf16);
+        xlang_delete_string(from_utf8);
+    }
+    SECTION("Long strings")
+    {
+        std::u16string const text = make_long_text();
+        xlang_string str{};
+        REQUIRE(xlang_create_string_dual_utf16(text.data(), static_cast<uint32_t>(text.size()), &str) == xlang_error_ok);
+        REQUIRE(get_view<char16_t>(str) == text);
+        REQUIRE(get_view<xlang_char8>(str) == to_utf8(text));
+        xlang_delete_string(str);
+    }
+    SECTION("Empty and invalid input")
+    {
+        xlang_string str = reinterpret_cast<xlang_string>(1);
+        REQUIRE(xlang_create_string_dual_utf8(nullptr, 0, &str) == xlang_error_ok);
+        REQUIRE(str == nullptr);
+        REQUIRE(xlang_create_string_dual_utf16(nullptr, 1, &str) == xlang_error_pointer);
+        REQUIRE(xlang_create_string_dual_utf16(u"a\xd800", 2, &str) == xlang_error_untranslatable_string);
+        REQUIRE(str == nullptr);
+    }
+}
+
+TEST_CASE("Inline string accessors")
+{
+    REQUIRE(xlang_get_string_layout_version() == XLANG_STRING_LAYOUT_VERSION);
+
+    xlang_string_header header;
+    xlang_string reference{};
+    REQUIRE(xlang_create_string_reference_utf8(u8"reference", 9, &header, &reference) == xlang_error_ok);
+    xlang_string dual{};
+    REQUIRE(xlang_create_string_dual_utf16(u"dual", 4, &dual) == xlang_error_ok);
+
+    xlang_string const strings[] = { nullptr, make_utf8(u8"Uri\u00e9"), make_utf16(u"Uri\u00e9"), reference, dual };
+
+    auto const check = [](xlang_string str)
+    {
+        REQUIRE(xlang_get_string_encoding_inline(str) == xlang_get_string_encoding(str));
+
+        xlang_char8 const* inline_utf8{};
+        xlang_char8 const* utf8{};
+        uint32_t inline_length{};
+        uint32_t length{};
+        REQUIRE(xlang_get_string_raw_buffer_utf8_inline(str, &inline_utf8, &inline_length) == xlang_error_ok);
+        REQUIRE(xlang_get_string_raw_buffer_utf8(str, &utf8, &length) == xlang_error_ok);
+        REQUIRE(std::basic_string_view<xlang_char8>{ inline_utf8, inline_length } == std::basic_string_view<xlang_char8>{ utf8, length });
+        REQUIRE(inline_utf8[inline_length] == 0);
+        if (str)
+        {
+            REQUIRE(inline_utf8 == utf8);
+        }
+
+        char16_t const* inline_utf16{};
+        char16_t const* utf16{};
+        REQUIRE(xlang_get_string_raw_buffer_utf16_inline(str, &inline_utf16, &inline_length) == xlang_error_ok);
+        REQUIRE(xlang_get_string_raw_buffer_utf16(str, &utf16, &length) == xlang_error_ok);
+        REQUIRE(std::u16string_view{ inline_utf16, inline_length } == std::u16string_view{ utf16, length });
+        REQUIRE(inline_utf16[inline_length] == 0);
+        if (str)
+        {
+            REQUIRE(inline_utf16 == utf16);
+        }
+    };
+
+    for (xlang_string str : strings)
+    {
+        // Before and after each string has acquired its alternate
+        check(str);
+        check(str);
+    }
+
+    for (xlang_string str : strings)
+    {
+        xlang_delete_string(str);
+    }
+}
+
+TEST_CASE("Copy string to buffer")
+{
+    xlang_string_header header;
+    xlang_string reference{};
+    REQUIRE(xlang_create_string_reference_utf16(u"Uri\u00e9\U0001f600", 6, &header, &reference) == xlang_error_ok);
+
+    SECTION("Converting into a buffer attaches no alternate")
+    {
+        xlang_char8 buffer[16]{};
+        uint32_t required{};
+        REQUIRE(xlang_copy_string_to_buffer_utf8(reference, buffer, 16, &required) == xlang_error_ok);
+        REQUIRE(required == 9);
+        REQUIRE(std::basic_string_view<xlang_char8>{ buffer } == u8"Uri\u00e9\U0001f600"sv);
+        REQUIRE(xlang_get_string_encoding(reference) == xlang_string_encoding::utf16);
+    }
+    SECTION("Exactly enough room, measured first")
+    {
+        xlang_char8 buffer[10]{};
+        uint32_t required{};
+        REQUIRE(xlang_copy_string_to_buffer_utf8(reference, buffer, 10, &required) == xlang_error_ok);
+        REQUIRE(required == 9);
+        REQUIRE(std::basic_string_view<xlang_char8>{ buffer } == u8"Uri\u00e9\U0001f600"sv);
+    }
+    SECTION("Too small a buffer reports the size needed")
+    {
+        xlang_char8 buffer[9]{};
+        uint32_t required{};
+        REQUIRE(xlang_copy_string_to_buffer_utf8(reference, buffer, 9, &required) == xlang_error_insufficient_buffer);
+        REQUIRE(required == 9);
+        REQUIRE(xlang_copy_string_to_buffer_utf8(reference, nullptr, 0, &required) == xlang_error_ok);
+        REQUIRE(required == 9);
+    }
+    SECTION("Native encoding")
+    {
+        char16_t buffer[7]{};
+        uint32_t required{};
+        REQUIRE(xlang_copy_string_to_buffer_utf16(reference, buffer, 7, &required) == xlang_error_ok);
+        REQUIRE(required == 6);
+        REQUIRE(std::u16string_view{ buffer } == u"Uri\u00e9\U0001f600"sv);
+        REQUIRE(xlang_copy_string_to_buffer_utf16(reference, buffer, 6, &required) == xlang_error_insufficient_buffer);
+        REQUIRE(required == 6);
+    }
+    SECTION("UTF-8 to UTF-16")
+    {
+        xlang_string str = make_utf8(u8"Uri\u00e9\U0001f600");
+        for (uint32_t size : { 7u, 64u })
+        {
+            std::u16string buffer(size, u'x');
+            uint32_t required{};
+            REQUIRE(xlang_copy_string_to_buffer_utf16(str, buffer.data(), size, &required) == xlang_error_ok);
+            REQUIRE(required == 6);
+            REQUIRE(buffer.substr(0, 7) == std::u16string_view{ u"Uri\u00e9\U0001f600", 7 });
+        }
+        REQUIRE(xlang_get_string_encoding(str) == xlang_string_encoding::utf8);
+        xlang_delete_string(str);
+    }
+    SECTION("Empty strings and errors")
+    {
+        char16_t buffer[1] = { u'x' };
+        uint32_t required = 1;
+        REQUIRE(xlang_copy_string_to_buffer_utf16(nullptr, buffer, 1, &required) == xlang_error_ok);
+        REQUIRE(required == 0);
+        REQUIRE(buffer[0] == 0);
+        REQUIRE(xlang_copy_string_to_buffer_utf16(nullptr, buffer, 0, &required) == xlang_error_insufficient_buffer);
+        REQUIRE(xlang_copy_string_to_buffer_utf16(reference, nullptr, 4, &required) == xlang_error_pointer);
+        REQUIRE(xlang_copy_string_to_buffer_utf16(reference, buffer, 1, nullptr) == xlang_error_pointer);
+
+        xlang_string invalid = make_utf16(u"\xd800"sv);
+        xlang_char8 output[8];
+        REQUIRE(xlang_copy_string_to_buffer_utf8(invalid, output, 8, &required) == xlang_error_untranslatable_string);
+        xlang_delete_string(invalid);
+    }
+
+    xlang_delete_string(reference);
+}
+
+TEST_CASE("Batch string creation")
+{
+    SECTION("Contents match the sources")
+    {
+        std::u16string const long_text = make_long_text();
+        std::vector<std::u16string> texts;
+        for (uint32_t i = 0; i < 1000; ++i)
+        {
+            texts.push_back(i % 7 == 0 ? u"" : i % 100 == 1 ? long_text : u"Windows.Foundation.Uri\u00e9" + std::u16string(i % 40, u'x'));
+        }
+
+        std::vector<xlang_string_source_utf16> sources;
+        std::vector<xlang_string_source_utf8> utf8_sources;
+        std::vector<std::basic_string<xlang_char8>> utf8_texts;
+        for (auto const& text : texts)
+        {
+            sources.push_back({ text.empty() ? nullptr : text.data(), static_cast<uint32_t>(text.size()) });
+            utf8_texts.push_back(to_utf8(text));
+        }
+        for (auto const& text : utf8_texts)
+        {
+            utf8_sources.push_back({ text.data(), static_cast<uint32_t>(text.size()) });
+        }
+
+        std::vector<xlang_string> strings(texts.size());
+        std::vector<xlang_string> utf8_strings(texts.size());
+        REQUIRE(xlang_create_strings_utf16(sources.data(), static_cast<uint32_t>(sources.size()), strings.data()) == xlang_error_ok);
+        REQUIRE(xlang_create_strings_utf8(utf8_sources.data(), static_cast<uint32_t>(utf8_sources.size()), utf8_strings.data()) == xlang_error_ok);
+
+        for (size_t i = 0; i < texts.size(); ++i)
+        {
+            REQUIRE((strings[i] == nullptr) == texts[i].empty());
+            REQUIRE((utf8_strings[i] == nullptr) == texts[i].empty());
+            REQUIRE(get_view<char16_t>(strings[i]) == texts[i]);
+            REQUIRE(get_view<xlang_char8>(strings[i]) == utf8_texts[i]);
+            REQUIRE(get_view<xlang_char8>(utf8_strings[i]) == utf8_texts[i]);
+        }
+
+        xlang_delete_strings(utf8_strings.data(), static_cast<uint32_t>(utf8_strings.size()));
+        xlang_delete_strings(strings.data(), static_cast<uint32_t>(strings.size()));
+    }
+    SECTION("Strings outlive the batch they were created in")
+    {
+        xlang_string_source_utf16 const sources[] = { { u"first", 5 }, { u"second", 6 }, { u"third", 5 }, { u"fourth", 6 } };
+        xlang_string strings[4]{};
+        REQUIRE(xlang_create_strings_utf16(sources, 4, strings) == xlang_error_ok);
+
+        // Small neighbours share an allocation
+        char16_t const* first = get_view<char16_t>(strings[0]).data();
+        char16_t const* second = get_view<char16_t>(strings[1]).data();
+        REQUIRE(second > first);
+        REQUIRE(second - first < 64);
+
+        xlang_string kept{};
+        REQUIRE(xlang_duplicate_string(strings[2], &kept) == xlang_error_ok);
+        REQUIRE(kept == strings[2]);
+        xlang_string other_thread{};
+        REQUIRE(xlang_duplicate_string(strings[3], &other_thread) == xlang_error_ok);
+
+        xlang_delete_string(strings[1]);
+        strings[1] = nullptr;
+        xlang_delete_strings(strings, 4);
+
+        std::thread([other_thread]
+        {
+            REQUIRE(get_view<char16_t>(other_thread) == u"fourth"sv);
+            xlang_delete_string(other_thread);
+        }).join();
+
+        REQUIRE(get_view<char16_t>(kept) == u"third"sv);
+        REQUIRE(get_view<xlang_char8>(kept) == u8"third"sv);
+        xlang_string const utf8 = make_utf8(u8"third");
+        REQUIRE(compare_ordinal(kept, utf8) == 0);
+        xlang_delete_string(utf8);
+        xlang_delete_string(kept);
+    }
+    SECTION("Failure creates nothing")
+    {
+        xlang_string_source_utf8 sources[] = { { u8"one", 3 }, { u8"two", 3 }, { u8"three", 5 }, { nullptr, 0 } };
+        xlang_string strings[4];
+
+        sources[3] = { nullptr, 1 };
+        REQUIRE(xlang_create_strings_utf8(sources, 4, strings) == xlang_error_pointer);
+
+        // Fails only after the first three have been packed
+        sources[3] = { u8"four", std::numeric_limits<uint32_t>::max() };
+        std::fill(std::begin(strings), std::end(strings), reinterpret_cast<xlang_string>(1));
+        REQUIRE(xlang_create_strings_utf8(sources, 4, strings) == xlang_error_mem_invalid_size);
+        for (xlang_string str : strings)
+        {
+            REQUIRE(str == nullptr);
+        }
+
+        REQUIRE(xlang_create_strings_utf8(nullptr, 0, nullptr) == xlang_error_ok);
+        REQUIRE(xlang_create_strings_utf8(nullptr, 1, strings) == xlang_error_pointer);
+        xlang_delete_strings(nullptr, 0);
+    }
+}
@@ -30,6 +30,34 @@ xlang_result xlang_create_string_reference(char_type const* source, uint32_t len
     }
 }
 
+template <typename char_type>
+xlang_result xlang_create_string_interned(char_type const* source, uint32_t length, xlang_string* str)
+{
+    static_assert(std::disjunction_v<std::is_same<char_type, xlang_char8>, std::is_same<char_type, char16_t>>);
+    if constexpr (std::is_same_v<char_type, xlang_char8>)
+    {
+        return xlang_create_string_interned_utf8(source, length, str);
+    }
+    else
+    {
+        return xlang_create_string_interned_utf16(source, length, str);
+    }
+}
+
+template <typename char_type>
+xlang_result xlang_create_string_static(char_type const* source, uint32_t length, xlang_string_header* header, xlang_string* str)
+{
+    static_assert(std::disjunction_v<std::is_same<char_type, xlang_char8>, std::is_same<char_type, char16_t>>);
+    if constexpr (std::is_same_v<char_type, xlang_char8>)
+    {
+        return xlang_create_string_static_utf8(source, length, header, str);
+    }
+    else
+    {
+        return xlang_create_string_static_utf16(source, length, header, str);
+    }
+}
+
 template <typename char_type>
 xlang_result xlang_get_string_raw_buffer(xlang_string str, char_type const* * buffer, uint32_t* length)
 {
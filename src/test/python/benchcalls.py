@@ -0,0 +1,29 @@
+import find_projection
+import timeit
+
+import pyrt.windows.data.json as wdj
+import pyrt.windows.devices.geolocation as wdg
+
+# Call overhead of generated methods: a method taking no arguments, a property read through its get method and
+# through the property itself, and an overloaded method called with three arguments. Run against projections
+# generated before and after a change to compare them.
+
+def measure(name, statement, number=200000):
+    seconds = min(timeit.repeat(statement, number=number, repeat=5))
+    print("{0:<40}{1:>10.1f} ns/call".format(name, seconds / number * 1e9))
+
+def main():
+    array = wdj.JsonArray()
+    locator = wdg.Geolocator()
+    positions = [wdg.BasicGeoposition(47.1, -122.1, 0.0)]
+
+    measure("JsonArray.Stringify()", lambda: array.Stringify())
+    measure("Geolocator.get_ReportInterval()", lambda: locator.get_ReportInterval())
+    measure("Geolocator.ReportInterval", lambda: locator.ReportInterval)
+    measure("GeoboundingBox.TryCompute(p, 0, 0)", lambda: wdg.GeoboundingBox.TryCompute(positions, 0, 0), number=20000)
+
+if __name__ == '__main__':
+    import _pyrt
+    _pyrt.init_apartment()
+    main()
+    _pyrt.uninit_apartment()
@@ -0,0 +1,38 @@
+import os
+import subprocess
+import sys
+
+# Import time of generated namespaces, and the cost of first using a type, which is when a namespace's types are
+# created. Each measurement runs in a new interpreter, since a namespace is only imported once per process. Run
+# against projections generated before and after a change to compare them.
+
+def run(setup, statement, repeat=10):
+    script = """
+import time
+import find_projection
+{0}
+start = time.perf_counter()
+{1}
+print(time.perf_counter() - start)
+""".format(setup, statement)
+
+    folder = os.path.dirname(os.path.abspath(__file__))
+    times = []
+    for _ in range(repeat):
+        output = subprocess.check_output([sys.executable, "-c", script], cwd=folder)
+        times.append(float(output))
+    return min(times)
+
+def measure(name, setup, statement):
+    print("{0:<50}{1:>10.2f} ms".format(name, run(setup, statement) * 1e3))
+
+def main():
+    measure("import pyrt", "", "import pyrt")
+    measure("import pyrt.windows.foundation", "import pyrt", "import pyrt.windows.foundation")
+    measure("import pyrt.windows.data.json", "import pyrt", "import pyrt.windows.data.json")
+    measure("import pyrt.windows.devices.geolocation", "import pyrt", "import pyrt.windows.devices.geolocation")
+    measure("first use of windows.data.json.JsonArray", "import pyrt.windows.data.json as wdj", "wdj.JsonArray")
+    measure("first use of windows.devices.geolocation.Geolocator", "import pyrt.windows.devices.geolocation as wdg", "wdg.Geolocator")
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,39 @@
+import find_projection
+import timeit
+
+import _pyrt
+import pyrt.windows.data.json as wdj
+
+# Iterating a 100,000 element collection: for loops over the wrapper fetch elements in batches through GetMany,
+# where stepping the iterator by hand takes a MoveNext and a Current call per element. A batch size of 1 shows the
+# cost of GetMany without the batching.
+
+# The test projection has no IVector<int32_t> to hand; JsonArray is an IVector<IJsonValue>, which also measures
+# wrapping each element.
+SIZE = 100000
+
+def iterate_by_hand(array):
+    it = array.First()
+    while it.get_HasCurrent():
+        it.get_Current()
+        it.MoveNext()
+
+def measure(name, statement, number=5):
+    seconds = min(timeit.repeat(statement, number=number, repeat=3))
+    print("{0:<40}{1:>10.1f} ns/element".format(name, seconds / number / SIZE * 1e9))
+
+def main():
+    array = wdj.JsonArray.Parse("[" + ",".join(str(i) for i in range(SIZE)) + "]")
+
+    measure("First/MoveNext/Current", lambda: iterate_by_hand(array))
+
+    for batch_size in (1, 16, 64, 256):
+        _pyrt.set_iterator_batch_size(batch_size)
+        measure("for loop, batches of {}".format(batch_size), lambda: [v for v in array])
+
+    _pyrt.set_iterator_batch_size(64)
+
+if __name__ == '__main__':
+    _pyrt.init_apartment()
+    main()
+    _pyrt.uninit_apartment()
@@ -0,0 +1,61 @@
+import find_projection
+import unittest
+import array
+
+import pyrt.windows.data.json as wdj
+import pyrt.windows.foundation as wf
+
+def int32_array(value):
+    return wf.IPropertyValue._from(wf.PropertyValue.CreateInt32Array(value))
+
+class TestArrays(unittest.TestCase):
+
+    def test_pass_array_list(self):
+        a = int32_array([1, 2, 3]).GetInt32Array()
+        self.assertEqual(a.tolist(), [1, 2, 3])
+
+    def test_pass_array_buffer(self):
+        a = int32_array(array.array('i', [4, 5, 6])).GetInt32Array()
+        self.assertEqual(a.tolist(), [4, 5, 6])
+
+        b = wf.IPropertyValue._from(wf.PropertyValue.CreateUInt8Array(b'\x01\x02')).GetUInt8Array()
+        self.assertEqual(bytes(b), b'\x01\x02')
+
+    def test_pass_array_other_buffer_type(self):
+        a = int32_array(array.array('q', [7, 8, 9])).GetInt32Array()
+        self.assertEqual(a.tolist(), [7, 8, 9])
+
+        with self.assertRaises(RuntimeError):
+            int32_array(array.array('q', [2 ** 40]))
+
+    def test_receive_array_memoryview(self):
+        a = int32_array(range(10)).GetInt32Array()
+        self.assertIsInstance(a, memoryview)
+        self.assertEqual(a.format, 'i')
+        self.assertEqual(a.itemsize, 4)
+        self.assertEqual(len(a), 10)
+        self.assertEqual(a[9], 9)
+
+    def test_receive_array_empty(self):
+        a = int32_array([]).GetInt32Array()
+        self.assertEqual(len(a), 0)
+
+    def test_receive_array_strings(self):
+        pv = wf.IPropertyValue._from(wf.PropertyValue.CreateStringArray(["plugh", "xyzzy"]))
+        self.assertEqual(pv.GetStringArray(), ["plugh", "xyzzy"])
+
+    def test_fill_array_list(self):
+        a = wdj.JsonArray.Parse("[1, 2, 3]")
+        items = [None] * 2
+        self.assertEqual(a.GetMany(1, items), 2)
+        self.assertEqual([item.GetNumber() for item in items], [2, 3])
+
+    def test_fill_array_not_a_list(self):
+        with self.assertRaises(TypeError):
+            wdj.JsonArray().GetMany(0, 2)
+
+if __name__ == '__main__':
+    import _pyrt
+    _pyrt.init_apartment()
+    unittest.main()
+    _pyrt.uninit_apartment()
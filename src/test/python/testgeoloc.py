@@ -13,6 +13,15 @@ class TestGeolocation(unittest.TestCase):
         self.assertEqual(type(op), wf.IAsyncOperation)
         op.Cancel()
 
+    def test_property_access(self):
+        locator = wdg.Geolocator()
+        locator.ReportInterval = 500
+        self.assertEqual(locator.ReportInterval, 500)
+        self.assertEqual(locator.get_ReportInterval(), 500)
+
+        with self.assertRaises(TypeError):
+            del locator.ReportInterval
+
     def test_struct_ctor(self):
         basic_pos = wdg.BasicGeoposition(Latitude = 47.1, Longitude = -122.1, Altitude = 0.0)
         self.assertEqual(basic_pos.Latitude, 47.1)
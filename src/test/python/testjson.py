@@ -42,6 +42,31 @@ class TestJson(unittest.TestCase):
         o = a.GetObjectAt(5)
         self.assertEqual(o.get_Size(), 0)
 
+    def test_JsonArray_wrapper_identity(self):
+        a = wdj.JsonArray.Parse('[{}, {}]')
+        o = a.GetObjectAt(0)
+        self.assertIs(a.GetObjectAt(0), o)
+        self.assertIsNot(a.GetObjectAt(1), o)
+
+        # Once the wrapper is gone, the object gets a new one that works just the same.
+        del o
+        self.assertEqual(a.GetObjectAt(0).get_Size(), 0)
+
+    def test_JsonArray_iterate(self):
+        a = wdj.JsonArray.Parse('[1, 2, 3, 4, 5, 6, 7]')
+        self.assertEqual([v.GetNumber() for v in a], [1, 2, 3, 4, 5, 6, 7])
+        self.assertEqual(len(list(a.GetView())), 7)
+
+        # Batches smaller than the collection, and not dividing it evenly
+        import _pyrt
+        try:
+            _pyrt.set_iterator_batch_size(3)
+            self.assertEqual([v.GetNumber() for v in a], [1, 2, 3, 4, 5, 6, 7])
+        finally:
+            _pyrt.set_iterator_batch_size(64)
+
+        self.assertEqual(list(wdj.JsonArray()), [])
+
     def test_JsonArray_GetView(self):
         a = wdj.JsonArray.Parse('[true, false, 42, null, [], {}, "plugh"]')
         view = a.GetView()
@@ -695,6 +695,11 @@ namespace xlang
 
     void write_consume_declaration(writer& w, MethodDef const& method)
     {
+        if (!is_used(method))
+        {
+            return;
+        }
+
         method_signature signature{ method };
         w.async_types = is_async(method, signature);
         auto method_name = get_name(method);
@@ -779,6 +784,11 @@ namespace xlang
 
         for (auto&& method : type.MethodList())
         {
+            if (!is_used(method))
+            {
+                continue;
+            }
+
             auto method_name = get_name(method);
             method_signature signature{ method };
             w.async_types = is_async(method, signature);
@@ -835,6 +845,58 @@ namespace xlang
         }
     }
 
+    void write_consume_instantiations(writer& w, TypeDef const& type, std::string_view const& keyword)
+    {
+        if (!empty(type.GenericParam()))
+        {
+            return;
+        }
+
+        std::vector<TypeDef> consumed;
+        auto type_category = get_category(type);
+
+        if (type_category == category::interface_type)
+        {
+            consumed.push_back(type);
+        }
+        else if (type_category != category::class_type || !get_default_interface(type))
+        {
+            return;
+        }
+
+        // The consume_t bases of interfaces and classes (see write_interface_requires, write_slow_class_requires and
+        // write_fast_class_requires). Generic interfaces are instantiated with their own arguments as well, so
+        // they are left to the compiler.
+        for (auto&&[interface_name, info] : get_interfaces(w, type))
+        {
+            if (type_category == category::class_type)
+            {
+                if (is_fast_class(type) ? (info.exclusive || info.base) : (info.defaulted && !info.base))
+                {
+                    continue;
+                }
+            }
+
+            if (info.type.type() == TypeDefOrRef::TypeDef)
+            {
+                consumed.push_back(info.type.TypeDef());
+            }
+            else if (info.type.type() == TypeDefOrRef::TypeRef)
+            {
+                consumed.push_back(find_required(info.type.TypeRef()));
+            }
+        }
+
+        for (auto&& interface_type : consumed)
+        {
+            w.write("    % struct consume_%<@::%>;\n",
+                keyword,
+                get_impl_name(interface_type.TypeNamespace(), interface_type.TypeName()),
+                type.TypeNamespace(),
+                type.TypeName());
+        }
+    }
+
     void write_consume(writer& w, TypeDef const& type)
     {
         auto format = R"(    template <typename D>
@@ -1481,7 +1543,10 @@ protected:
         {
             for (auto&& method : info.methods)
             {
-                method_usage[get_name(method)].insert(interface_name);
+                if (is_used(method))
+                {
+                    method_usage[get_name(method)].insert(interface_name);
+                }
             }
         }
 
@@ -1511,16 +1576,18 @@ protected:
 
         for (auto&&[interface_name, info] : get_interfaces(w, type))
         {
-            if (info.defaulted && !info.base)
+            for (auto&& method : info.methods)
             {
-                for (auto&& method : info.methods)
+                if (!is_used(method))
+                {
+                    continue;
+                }
+
+                if (info.defaulted && !info.base)
                 {
                     method_usage[get_name(method)].insert(default_interface_name);
                 }
-            }
-            else
-            {
-                for (auto&& method : info.methods)
+                else
                 {
                     method_usage[get_name(method)].insert(interface_name);
                 }
@@ -1995,6 +2062,11 @@ protected:
 
         for (auto&& method : factory.type.MethodList())
         {
+            if (!is_used(method))
+            {
+                continue;
+            }
+
             method_signature signature{ method };
             auto method_name = get_name(method);
             w.async_types = is_async(method, signature);
@@ -2024,6 +2096,11 @@ protected:
 
     void write_static_definitions(writer& w, MethodDef const& method, std::string_view const& type_name, TypeDef const& factory)
     {
+        if (!is_used(method))
+        {
+            return;
+        }
+
         auto format = R"(    inline % %::%(%)
     {
         %impl::call_factory<%, %>([&](auto&& f) { return f.%(%); });
@@ -2098,6 +2175,11 @@ protected:
         {
             for (auto&& method : info.methods)
             {
+                if (!is_used(method))
+                {
+                    continue;
+                }
+
                 auto method_name = get_name(method);
                 method_signature signature{ method };
                 w.async_types = is_async(method, signature);
@@ -2171,7 +2253,7 @@ protected:
     {
         %(std::nullptr_t) noexcept {}
         %(take_ownership_from_abi_t, void* ptr) noexcept : %(take_ownership_from_abi, ptr) {}
-%%%    };
+%%%%    };
 )";
 
         w.write(format,
@@ -2184,6 +2266,7 @@ protected:
             base_type,
             bind<write_constructor_declarations>(type, factories),
             bind<write_class_usings>(type),
+            bind_each<write_consume_declaration>(get_direct_methods(type)),
             bind_each<write_static_declaration>(factories));
     }
 
@@ -2367,10 +2450,201 @@ protected:
         }
     }
 
+    void write_component_activation_case(writer& w, TypeDef const& type, uint64_t slot)
+    {
+        auto type_name = type.TypeName();
+        auto type_namespace = type.TypeNamespace();
+
+        if (settings.component_opt)
+        {
+            auto format = R"(    case %:
+        return winrt_make_%();
+)";
+
+            w.write(format,
+                slot,
+                get_impl_name(type_namespace, type_name));
+        }
+        else
+        {
+            auto format = R"(    case %:
+        return winrt::detach_abi(winrt::make<winrt::@::factory_implementation::%>());
+)";
+
+            w.write(format,
+                slot,
+                type_namespace,
+                type_name);
+        }
+    }
+
+    void write_component_activation_dispatch(writer& w, std::vector<TypeDef> const& classes)
+    {
+        std::vector<TypeDef> types;
+        std::vector<std::string> full_names;
+
+        for (auto&& type : classes)
+        {
+            if (has_factory_members(type))
+            {
+                types.push_back(type);
+                full_names.push_back(std::string{ type.TypeNamespace() } + "." + std::string{ type.TypeName() });
+            }
+        }
+
+        // Hashing wide and narrow code units only agrees for ASCII, so anything else keeps the compare chain.
+        std::optional<perfect_hash_table> table;
+
+        if (!types.empty() && std::all_of(full_names.begin(), full_names.end(), [](std::string const& name) { return is_ascii(name); }))
+        {
+            table = make_perfect_hash({ full_names.begin(), full_names.end() });
+        }
+
+        if (!table)
+        {
+            auto format = R"(    auto requal = [](std::wstring_view const& left, std::wstring_view const& right) noexcept
+    {
+        return std::equal(left.rbegin(), left.rend(), right.rbegin(), right.rend());
+    };
+%
+    return nullptr;
+)";
+
+            w.write(format, bind_each<write_component_activation>(classes));
+            return;
+        }
+
+        auto const count = static_cast<uint64_t>(types.size());
+
+        auto format = R"(    static constexpr uint32_t seeds[]
+    {%
+    };
+
+    static constexpr std::wstring_view names[]
+    {%
+    };
+
+    uint32_t const key = winrt::impl::perfect_hash_key(name, %);
+    uint32_t const slot = winrt::impl::perfect_hash_slot(key, seeds[winrt::impl::perfect_hash_slot(key, 0, %)], %);
+
+    if (name != names[slot])
+    {
+        return nullptr;
+    }
+
+    switch (slot)
+    {
+%    }
+
+    return nullptr;
+)";
+
+        w.write(format,
+            [&](writer& w)
+            {
+                for (uint64_t seed : table->seeds)
+                {
+                    w.write("\n        %,", seed);
+                }
+            },
+            [&](writer& w)
+            {
+                for (uint32_t index : table->slots)
+                {
+                    w.write("\n        L\"%\",", full_names[index]);
+                }
+            },
+            static_cast<uint64_t>(table->suffix_length),
+            count,
+            count,
+            [&](writer& w)
+            {
+                for (uint64_t slot = 0; slot != table->slots.size(); ++slot)
+                {
+                    write_component_activation_case(w, types[table->slots[slot]], slot);
+                }
+            });
+    }
+
+    // With -register, module.g.cpp also registers the component with the xlang PAL while the program is being
+    // initialized, so a statically linked component activates without a library of its own. There is one
+    // registration per namespace with an activatable class, and each forwards to %_get_activation_factory.
+    void write_component_registration(writer& w, std::vector<TypeDef> const& classes)
+    {
+        if (!settings.component_register)
+        {
+            return;
+        }
+
+        std::set<std::string_view> namespaces;
+
+        for (auto&& type : classes)
+        {
+            if (has_factory_members(type))
+            {
+                namespaces.insert(type.TypeNamespace());
+            }
+        }
+
+        if (namespaces.empty())
+        {
+            return;
+        }
+
+        auto format = R"(
+namespace
+{
+    xlang_result XLANG_CALL %_xlang_get_activation_factory(xlang_string class_name, xlang_guid const& iid, void** factory) noexcept
+    {
+        *factory = nullptr;
+        char16_t const* buffer{};
+        uint32_t length{};
+        xlang_result const result = xlang_get_string_raw_buffer_utf16(class_name, &buffer, &length);
+
+        if (result != xlang_error_ok)
+        {
+            return result;
+        }
+
+        try
+        {
+            void* const activation_factory = %_get_activation_factory({ reinterpret_cast<wchar_t const*>(buffer), length });
+
+            if (!activation_factory)
+            {
+                return xlang_error_class_not_available;
+            }
+
+            winrt::Windows::Foundation::IUnknown const owner{ activation_factory, winrt::take_ownership_from_abi };
+            return static_cast<xlang_result>(owner.as(reinterpret_cast<winrt::guid const&>(iid), factory));
+        }
+        catch (...)
+        {
+            return static_cast<xlang_result>(winrt::to_hresult());
+        }
+    }
+%}
+)";
+
+        w.write(format,
+            settings.component_lib,
+            settings.component_lib,
+            [&](writer& w)
+            {
+                for (auto&& ns : namespaces)
+                {
+                    w.write("\n    xlang_activation_factory_registration const %_registration{ \"%\", &%_xlang_get_activation_factory };\n",
+                        get_impl_name(ns),
+                        ns,
+                        settings.component_lib);
+                }
+            });
+    }
+
     void write_module_g_cpp(writer& w, std::vector<TypeDef> const& classes)
     {
         auto format = R"(#include "winrt/base.h"
-%
+%%
 bool WINRT_CALL %_can_unload_now() noexcept
 {
     if (winrt::get_module_lock())
@@ -2384,13 +2658,7 @@ bool WINRT_CALL %_can_unload_now() noexcept
 
 void* WINRT_CALL %_get_activation_factory(std::wstring_view const& name)
 {
-    auto requal = [](std::wstring_view const& left, std::wstring_view const& right) noexcept
-    {
-        return std::equal(left.rbegin(), left.rend(), right.rbegin(), right.rend());
-    };
-%
-    return nullptr;
-}
+%}
 
 int32_t WINRT_CALL WINRT_CanUnloadNow() noexcept
 {
@@ -2427,15 +2695,17 @@ int32_t WINRT_CALL WINRT_GetActivationFactory(void* classId, void** factory) noe
     }
     catch (...) { return winrt::to_hresult(); }
 }
-)";
+%)";
 
         w.write(format,
+            settings.component_register ? "#include \"pal.h\"\n" : "",
             bind_each<write_component_include>(classes),
             settings.component_lib,
             settings.component_lib,
-            bind_each<write_component_activation>(classes),
+            bind<write_component_activation_dispatch>(classes),
             settings.component_lib,
-            settings.component_lib);
+            settings.component_lib,
+            bind<write_component_registration>(classes));
     }
 
     void write_component_interfaces(writer& w, TypeDef const& type)
@@ -2555,6 +2825,72 @@ int32_t WINRT_CALL WINRT_GetActivationFactory(void* classId, void** factory) noe
         }
     }
 
+    void write_component_direct_definitions(writer& w, TypeDef const& type)
+    {
+        auto methods = get_direct_methods(type);
+
+        if (empty(methods))
+        {
+            return;
+        }
+
+        auto type_name = type.TypeName();
+        auto type_namespace = type.TypeNamespace();
+        auto interface_name = w.write_temp("%", get_default_interface(type));
+
+        for (auto&& method : methods)
+        {
+            auto method_name = get_name(method);
+            method_signature signature{ method };
+            w.async_types = is_async(method, signature);
+
+            auto format = R"(    % %::%(%) const%
+    {
+        if (auto self = impl::try_get_local<@::implementation::%>(*this))
+        {
+            return self->%(%);
+        }
+
+        return static_cast<% const&>(*this).%(%);
+    }
+)";
+
+            w.write(format,
+                signature.return_signature(),
+                type_name,
+                method_name,
+                bind<write_consume_params>(signature),
+                is_noexcept(method) ? " noexcept" : "",
+                type_namespace,
+                type_name,
+                method_name,
+                bind<write_consume_args>(signature),
+                interface_name,
+                method_name,
+                bind<write_consume_args>(signature));
+
+            if (is_add_overload(method))
+            {
+                format = R"(    %::%_revoker %::%(auto_revoke_t, %) const
+    {
+        return impl::make_event_revoker<%, %_revoker>(this, %(%));
+    }
+)";
+
+                w.write(format,
+                    type_name,
+                    method_name,
+                    type_name,
+                    method_name,
+                    bind<write_consume_params>(signature),
+                    type_name,
+                    method_name,
+                    method_name,
+                    bind<write_consume_args>(signature));
+            }
+        }
+    }
+
     void write_component_g_cpp(writer& w, TypeDef const& type)
     {
         auto type_name = type.TypeName();
@@ -2583,6 +2919,9 @@ void* winrt_make_%()
 
         write_type_namespace(w, type_namespace);
 
+        // Objects made here record their vtable, which is how direct calls recognize them.
+        std::string_view make_name = empty(get_direct_methods(type)) ? "make" : "impl::make_local";
+
         for (auto&& factory : get_factories(type))
         {
             if (factory.activatable)
@@ -2590,7 +2929,7 @@ void* winrt_make_%()
                 if (!factory.type)
                 {
                     auto format = R"(    %::%() :
-        %(make<@::implementation::%>())
+        %(%<@::implementation::%>())
     {
     }
 )";
@@ -2599,6 +2938,7 @@ void* winrt_make_%()
                         type_name,
                         type_name,
                         type_name,
+                        make_name,
                         type_namespace,
                         type_name);
                 }
@@ -2609,7 +2949,7 @@ void* winrt_make_%()
                         method_signature signature{ method };
 
                         auto format = R"(    %::%(%) :
-        %(make<@::implementation::%>(%))
+        %(%<@::implementation::%>(%))
     {
     }
 )";
@@ -2619,6 +2959,7 @@ void* winrt_make_%()
                             type_name,
                             bind<write_consume_params>(signature),
                             type_name,
+                            make_name,
                             type_namespace,
                             type_name,
                             bind<write_consume_args>(signature));
@@ -2659,6 +3000,7 @@ void* winrt_make_%()
 
         if (!is_fast_class(type))
         {
+            write_component_direct_definitions(w, type);
             write_close_namespace(w);
             return;
         }
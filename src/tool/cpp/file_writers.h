@@ -34,6 +34,7 @@ namespace xlang
         w.write(strings::base_types);
         w.write(strings::base_shims);
         w.write(strings::base_activation);
+        w.write(strings::base_perfect_hash);
         w.write(strings::base_implements);
         w.write(strings::base_produce);
         w.write(strings::base_composable);
@@ -167,6 +168,13 @@ namespace xlang
         w.type_namespace = ns;
 
         write_impl_namespace(w);
+
+        if (settings.extern_templates)
+        {
+            w.write_each<write_consume_instantiations>(members.interfaces, "extern template");
+            w.write_each<write_consume_instantiations>(members.classes, "extern template");
+        }
+
         w.write_each<write_consume_definitions>(members.interfaces);
         w.write_each<write_delegate_implementation>(members.delegates);
         w.write_each<write_produce>(members.interfaces);
@@ -199,6 +207,29 @@ namespace xlang
         w.save_header();
     }
 
+    void write_namespace_cpp(std::string_view const& ns, cache::namespace_members const& members)
+    {
+        writer w;
+        w.type_namespace = ns;
+
+        write_impl_namespace(w);
+        w.write_each<write_consume_instantiations>(members.interfaces, "template");
+        w.write_each<write_consume_instantiations>(members.classes, "template");
+        write_close_namespace(w);
+
+        w.swap();
+        write_license(w);
+        w.write_depends(w.type_namespace);
+
+        // Interfaces from other namespaces need their consume definitions too.
+        for (auto&& depends : w.depends)
+        {
+            w.write_depends(depends.first);
+        }
+
+        w.flush_to_file(settings.output_folder + settings.root + "/" + std::string{ ns } + ".cpp");
+    }
+
     void write_module_g_cpp(std::vector<TypeDef> const& classes)
     {
         writer w;
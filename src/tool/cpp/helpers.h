@@ -134,6 +134,34 @@ namespace xlang
         return {};
     }
 
+    // Under -direct, a component's own slow classes declare the methods of their default interface themselves, so
+    // that calls on objects implemented in the same binary can skip the ABI. Fast classes already call straight
+    // into the implementation, and generic default interfaces are left alone.
+    std::pair<MethodDef, MethodDef> get_direct_methods(TypeDef const& type)
+    {
+        if (!settings.component_direct || !settings.filter.includes(type) || is_fast_class(type))
+        {
+            return {};
+        }
+
+        auto default_interface = get_default_interface(type);
+
+        if (!default_interface)
+        {
+            return {};
+        }
+
+        switch (default_interface.type())
+        {
+        case TypeDefOrRef::TypeDef:
+            return default_interface.TypeDef().MethodList();
+        case TypeDefOrRef::TypeRef:
+            return find_required(default_interface.TypeRef()).MethodList();
+        default:
+            return {};
+        }
+    }
+
     auto get_abi_name(MethodDef const& method)
     {
         if (auto overload = get_attribute(method, "Windows.Foundation.Metadata", "OverloadAttribute"))
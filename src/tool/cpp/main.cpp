@@ -4,6 +4,8 @@
 #include "settings.h"
 #include "type_writers.h"
 #include "helpers.h"
+#include "perfect_hash.h"
+#include "usage.h"
 #include "code_writers.h"
 #include "file_writers.h"
 #include "type_writers.h"
@@ -33,8 +35,12 @@ namespace xlang
             { "exclude", 0 },
             { "root", 0, 1 },
             { "base", 0, 0 },
+            { "extern", 0, 0 },
+            { "usage", 0, 1 },
             { "lib", 0, 1 },
-            { "opt", 0, 0 }
+            { "opt", 0, 0 },
+            { "direct", 0, 0 },
+            { "register", 0, 0 }
         };
 
         cmd::reader args{ argc, argv, options };
@@ -50,6 +56,9 @@ namespace xlang
         settings.reference = args.files("reference");
         settings.component = args.exists("component");
         settings.base = args.exists("base");
+        settings.extern_templates = args.exists("extern");
+        settings.usage = args.value("usage");
+        settings.prune = !settings.usage.empty();
 
         auto output_folder = canonical(args.value("output"));
         create_directories(output_folder / settings.root / "impl");
@@ -78,7 +87,9 @@ namespace xlang
             settings.component_pch = args.value("pch", "pch.h");
             settings.component_prefix = args.exists("prefix");
             settings.component_lib = args.value("lib", "winrt");
-            settings.component_opt = args.exists("opt");
+            settings.component_direct = args.exists("direct");
+            settings.component_register = args.exists("register");
+            settings.component_opt = args.exists("opt") || settings.component_direct;
 
             if (settings.component_pch == ".")
             {
@@ -144,6 +155,11 @@ namespace xlang
             supplement_includes(c);
             settings.filter = { settings.include, settings.exclude };
 
+            if (settings.prune)
+            {
+                resolve_usage(c);
+            }
+
             if (settings.verbose)
             {
                 w.write(" tool:  % (C++/WinRT v%)\n", canonical(argv[0]).string(), XLANG_VERSION_STRING);
@@ -164,6 +180,11 @@ namespace xlang
                 {
                     w.write(" cout:  %\n", settings.component_folder);
                 }
+
+                if (settings.prune)
+                {
+                    w.write(" usage: %\n", settings.usage);
+                }
             }
 
             w.flush_to_console();
@@ -182,6 +203,11 @@ namespace xlang
                     write_namespace_1_h(ns, members);
                     write_namespace_2_h(ns, members, c);
                     write_namespace_h(c, ns, members);
+
+                    if (settings.extern_templates)
+                    {
+                        write_namespace_cpp(ns, members);
+                    }
                 });
             }
 
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "strings/base_perfect_hash.h"
+
+namespace xlang
+{
+    // Minimal perfect hashing (hash and displace) over a fixed set of class names, computed when code is generated.
+    // A name is hashed once, and only its length and last few characters, since class names in a component tend
+    // to share long prefixes; the generated lookup then mixes that key with zero to choose a bucket, and with the
+    // bucket's seed to choose a slot, and verifies the name with one compare. The key and mix are the ones base.h
+    // carries, so the generated lookup calls the very functions the table was built with.
+    //
+    // Names are hashed one code unit at a time, which only gives the same result for narrow and wide strings when
+    // every name is ASCII; callers fall back to comparing names otherwise.
+    using winrt::impl::perfect_hash_key;
+    using winrt::impl::perfect_hash_slot;
+
+    struct perfect_hash_table
+    {
+        uint32_t suffix_length{};
+
+        // One per bucket: the seed that places that bucket's names in free slots
+        std::vector<uint32_t> seeds;
+
+        // One per slot: the index of the name that hashes to it
+        std::vector<uint32_t> slots;
+    };
+
+    inline bool is_ascii(std::string_view const& value) noexcept
+    {
+        return std::all_of(value.begin(), value.end(), [](char c) { return static_cast<unsigned char>(c) < 0x80; });
+    }
+
+    // For n unique names, both tables have n entries, and the slot of a name is
+    //
+    //     perfect_hash_slot(key, seeds[perfect_hash_slot(key, 0, n)], n)
+    //
+    // where key is perfect_hash_key(name, suffix_length). Returns nothing if no key tells every name apart, which
+    // takes a 32-bit collision between two whole names.
+    inline std::optional<perfect_hash_table> make_perfect_hash(std::vector<std::string_view> const& names)
+    {
+        auto const count = static_cast<uint32_t>(names.size());
+        perfect_hash_table table;
+
+        if (count == 0)
+        {
+            return table;
+        }
+
+        size_t const longest = std::max_element(names.begin(), names.end(), [](std::string_view const& left, std::string_view const& right)
+        {
+            return left.size() < right.size();
+        })->size();
+
+        std::vector<uint32_t> keys(count);
+
+        for (;; ++table.suffix_length)
+        {
+            std::unordered_set<uint32_t> unique;
+
+            for (uint32_t index = 0; index < count; ++index)
+            {
+                keys[index] = perfect_hash_key(names[index], table.suffix_length);
+                unique.insert(keys[index]);
+            }
+
+            if (unique.size() == count)
+            {
+                break;
+            }
+
+            if (table.suffix_length >= longest)
+            {
+                return std::nullopt;
+            }
+        }
+
+        std::vector<std::vector<uint32_t>> buckets(count);
+
+        for (uint32_t index = 0; index < count; ++index)
+        {
+            buckets[perfect_hash_slot(keys[index], 0, count)].push_back(index);
+        }
+
+        // Place the largest buckets first, while most slots are still free.
+        std::vector<uint32_t> order(count);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t left, uint32_t right)
+        {
+            return buckets[left].size() > buckets[right].size();
+        });
+
+        constexpr uint32_t unused = UINT32_MAX;
+        table.seeds.assign(count, 0);
+        table.slots.assign(count, unused);
+        std::vector<uint32_t> candidates;
+
+        for (uint32_t bucket : order)
+        {
+            if (buckets[bucket].empty())
+            {
+                break;
+            }
+
+            // Keys are distinct and the mix is a bijection, so each seed scatters a bucket's names afresh.
+            for (uint32_t seed = 1;; ++seed)
+            {
+                candidates.clear();
+
+                for (uint32_t index : buckets[bucket])
+                {
+                    uint32_t const slot = perfect_hash_slot(keys[index], seed, count);
+
+                    if (table.slots[slot] != unused || std::find(candidates.begin(), candidates.end(), slot) != candidates.end())
+                    {
+                        break;
+                    }
+
+                    candidates.push_back(slot);
+                }
+
+                if (candidates.size() == buckets[bucket].size())
+                {
+                    table.seeds[bucket] = seed;
+
+                    for (size_t i = 0; i != candidates.size(); ++i)
+                    {
+                        table.slots[candidates[i]] = buckets[bucket][i];
+                    }
+
+                    break;
+                }
+            }
+        }
+
+        return table;
+    }
+}
@@ -10,6 +10,7 @@ namespace xlang
         std::string output_folder;
         std::string root{ "winrt" };
         bool base{};
+        bool extern_templates{};
 
         bool component{};
         std::string component_folder;
@@ -19,9 +20,15 @@ namespace xlang
         bool component_overwrite{};
         std::string component_lib;
         bool component_opt{};
+        bool component_direct{};
+        bool component_register{};
 
         bool verbose{};
 
+        std::string usage;
+        bool prune{};
+        std::set<std::string> used_methods;
+
         std::set<std::string> include;
         std::set<std::string> exclude;
 
@@ -1312,3 +1312,32 @@ WINRT_EXPORT namespace winrt
         friend struct weak_ref;
     };
 }
+
+namespace winrt::impl
+{
+    // Direct calls (-direct). An object's vtable pointer identifies its most derived type within a binary, so
+    // comparing it with one recorded from an object known to be a D tells whether a projected class wraps this
+    // binary's implementation without calling through the ABI. Objects implemented elsewhere, by a type derived
+    // from D, or seen before any D has been made here, don't match and take the ABI as usual.
+    template <typename D>
+    inline std::atomic<void const*> local_vtable{};
+
+    template <typename D, typename... Args>
+    auto make_local(Args&&... args)
+    {
+        auto result = make<D>(std::forward<Args>(args)...);
+        local_vtable<D>.store(*static_cast<void const* const*>(get_abi(result)), std::memory_order_relaxed);
+        return result;
+    }
+
+    template <typename D, typename I>
+    D* try_get_local(I const& object) noexcept
+    {
+        if (*static_cast<void const* const*>(get_abi(object)) != local_vtable<D>.load(std::memory_order_relaxed))
+        {
+            return nullptr;
+        }
+
+        return get_self<D>(object);
+    }
+}
@@ -0,0 +1,30 @@
+
+namespace winrt::impl
+{
+    // Used by the cpp tool to build the activation lookup in module.g.cpp and by that lookup to search it, so
+    // the two always agree. Only the length and the last suffix_length code units of a name are hashed.
+    template <typename Char>
+    constexpr uint32_t perfect_hash_key(std::basic_string_view<Char> const& value, uint32_t suffix_length) noexcept
+    {
+        // FNV-1a over the suffix, starting from the length
+        uint32_t result = 0x811C9DC5 ^ static_cast<uint32_t>(value.size());
+
+        for (size_t i = value.size() - (std::min)(value.size(), size_t{ suffix_length }); i != value.size(); ++i)
+        {
+            result = (result ^ static_cast<uint32_t>(value[i])) * 0x01000193;
+        }
+
+        return result;
+    }
+
+    constexpr uint32_t perfect_hash_slot(uint32_t key, uint32_t seed, uint32_t count) noexcept
+    {
+        uint32_t result = key ^ seed;
+        result ^= result >> 16;
+        result *= 0x85EBCA6B;
+        result ^= result >> 13;
+        result *= 0xC2B2AE35;
+        result ^= result >> 16;
+        return result % count;
+    }
+}
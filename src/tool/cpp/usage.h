@@ -0,0 +1,191 @@
+#pragma once
+
+namespace xlang
+{
+    // Member-level pruning (-usage). The manifest lists one name per line, either a type ("Windows.Storage.StorageFile")
+    // to keep every member of, or a member ("Windows.Storage.StorageFile.GetFileFromPathAsync") using its projected
+    // name, so a property keeps both its accessors and an event both add and remove. Blank lines and lines starting
+    // with '#' are ignored, as are names that aren't in the metadata.
+    //
+    // Only the consuming side is pruned: consume methods, the class methods forwarding to them and the usings that
+    // disambiguate them. ABI declarations and produce stubs are left alone, since they make up the vtable.
+
+    inline bool is_usage_exempt(TypeDef const& type)
+    {
+        // Interfaces consumed by base.h, or by the code write_namespace_special adds to these namespaces
+        static constexpr std::string_view exempt[]
+        {
+            "Windows.Foundation",
+            "Windows.Foundation.Collections",
+            "Windows.UI.Core",
+            "Windows.UI.Xaml.Interop",
+        };
+
+        if (!empty(type.GenericParam()))
+        {
+            return true;
+        }
+
+        if (std::find(std::begin(exempt), std::end(exempt), type.TypeNamespace()) != std::end(exempt))
+        {
+            return true;
+        }
+
+        // A component's own types are implemented alongside the projection.
+        return settings.component && settings.filter.includes(type);
+    }
+
+    // Methods are keyed by name rather than by row, since rows from different metadata files don't compare.
+    inline std::string get_usage_key(MethodDef const& method)
+    {
+        auto type = method.Parent();
+        std::string key{ type.TypeNamespace() };
+        key += '.';
+        key += type.TypeName();
+        key += '.';
+        key += method.Name();
+        return key;
+    }
+
+    inline bool is_used(MethodDef const& method)
+    {
+        if (!settings.prune)
+        {
+            return true;
+        }
+
+        return is_usage_exempt(method.Parent()) || settings.used_methods.find(get_usage_key(method)) != settings.used_methods.end();
+    }
+
+    inline void resolve_usage(cache const& c)
+    {
+        std::ifstream file{ settings.usage };
+
+        if (!file)
+        {
+            throw_invalid("Usage manifest '", settings.usage, "' could not be read");
+        }
+
+        std::set<std::string> types;
+        std::map<std::string, std::set<std::string>> members;
+        std::string line;
+
+        while (std::getline(file, line))
+        {
+            auto first = line.find_first_not_of(" \t\r");
+            auto last = line.find_last_not_of(" \t\r");
+
+            if (first == std::string::npos || line[first] == '#')
+            {
+                continue;
+            }
+
+            auto name = line.substr(first, last - first + 1);
+
+            if (c.find(name))
+            {
+                types.insert(name);
+            }
+            else if (auto pos = name.rfind('.'); pos != std::string::npos && c.find(name.substr(0, pos)))
+            {
+                members[name.substr(0, pos)].insert(name.substr(pos + 1));
+            }
+        }
+
+        auto resolve = [](interface_info const& info)
+        {
+            switch (info.type.type())
+            {
+            case TypeDefOrRef::TypeDef:
+                return info.type.TypeDef();
+            case TypeDefOrRef::TypeRef:
+                return find_required(info.type.TypeRef());
+            default:
+                // Generic instances are exempt.
+                return TypeDef{};
+            }
+        };
+
+        auto keep = [&](TypeDef const& interface_type, std::set<std::string> const* names)
+        {
+            if (!interface_type)
+            {
+                return;
+            }
+
+            for (auto&& method : interface_type.MethodList())
+            {
+                if (!names || names->find(std::string{ get_name(method) }) != names->end())
+                {
+                    settings.used_methods.insert(get_usage_key(method));
+                }
+            }
+        };
+
+        writer w;
+
+        for (auto&&[ns, namespace_members] : c.namespaces())
+        {
+            for (auto&& type : namespace_members.classes)
+            {
+                // Constructors and overrides aren't named in manifests, so their interfaces are kept whole.
+                for (auto&& factory : get_factories(type))
+                {
+                    if (factory.type && (factory.activatable || factory.composable))
+                    {
+                        keep(factory.type, nullptr);
+                    }
+                }
+
+                for (auto&&[interface_name, info] : get_interfaces(w, type))
+                {
+                    if (info.overridable)
+                    {
+                        keep(resolve(info), nullptr);
+                    }
+                }
+            }
+        }
+
+        auto keep_type = [&](TypeDef const& type, std::set<std::string> const* names)
+        {
+            auto type_category = get_category(type);
+
+            if (type_category == category::interface_type)
+            {
+                keep(type, names);
+            }
+            else if (type_category != category::class_type)
+            {
+                return;
+            }
+
+            // Members reached through the type's required interfaces, as the projection makes them available
+            for (auto&&[interface_name, info] : get_interfaces(w, type))
+            {
+                keep(resolve(info), names);
+            }
+
+            if (type_category == category::class_type)
+            {
+                for (auto&& factory : get_factories(type))
+                {
+                    if (factory.statics)
+                    {
+                        keep(factory.type, names);
+                    }
+                }
+            }
+        };
+
+        for (auto&& name : types)
+        {
+            keep_type(c.find(name), nullptr);
+        }
+
+        for (auto&&[name, names] : members)
+        {
+            keep_type(c.find(name), &names);
+        }
+    }
+}
@@ -2,14 +2,14 @@
 
 namespace xlang
 {
-    void write_import_type(writer& w, TypeDef const& type)
+    void write_import_type_name(writer& w, TypeDef const& type)
     {
         if (is_exclusive_to(type))
         {
             return;
         }
 
-        w.write("@ = _internal.@\n", type.TypeName(), type.TypeName());
+        w.write("    \"@\",\n", type.TypeName());
     }
 
     void write_include(writer& w, std::string_view const& ns)
@@ -140,36 +140,22 @@ namespace xlang
     {
         XLANG_ASSERT(methods.size() > 0);
 
-        if (methods.size() == 1)
+        if (is_fastcall(methods))
         {
-            auto method = methods[0].method;
-
-            if (is_get_method(method))
-            {
-                w.write("METH_NOARGS");
-            }
-            else if (is_put_method(method) || is_add_method(method) || is_remove_method(method))
-            {
-                w.write("METH_O");
-            }
-            else
-            {
-                w.write("METH_VARARGS");
-            }
-
-            if (method.Flags().Static())
-            {
-                w.write(" | METH_STATIC");
-            }
+            w.write("METH_FASTCALL");
+        }
+        else if (is_get_method(methods[0].method))
+        {
+            w.write("METH_NOARGS");
         }
         else
         {
-            w.write("METH_VARARGS");
+            w.write("METH_O");
+        }
 
-            if (methods[0].method.Flags().Static())
-            {
-                w.write(" | METH_STATIC");
-            }
+        if (methods[0].method.Flags().Static())
+        {
+            w.write(" | METH_STATIC");
         }
     }
 
@@ -191,6 +177,63 @@ namespace xlang
         w.write("    { nullptr }\n};\n");
     }
 
+    void write_property_table(writer& w, TypeDef const& type)
+    {
+        auto properties = get_instance_properties(get_methods(type));
+
+        if (properties.empty())
+        {
+            return;
+        }
+
+        for (auto&&[name, accessors] : properties)
+        {
+            if (!accessors.set)
+            {
+                continue;
+            }
+
+            auto format = R"(
+static int @_set_%(%* self, PyObject* value, void* /*unused*/)
+{
+    if (value == nullptr)
+    {
+        PyErr_SetString(PyExc_TypeError, "property delete not supported");
+        return -1;
+    }
+
+    PyObject* result = @_%(self, value);
+    if (result == nullptr)
+    {
+        return -1;
+    }
+
+    Py_DECREF(result);
+    return 0;
+}
+)";
+            w.write(format,
+                type.TypeName(),
+                name,
+                bind<write_winrt_wrapper>(type),
+                type.TypeName(),
+                accessors.set.Name());
+        }
+
+        w.write("\nstatic PyGetSetDef @_getset[] = {\n", type.TypeName());
+
+        for (auto&&[name, accessors] : properties)
+        {
+            // The get method is METH_NOARGS, so it's passed null for its second argument, as the getter is here.
+            w.write("    { const_cast<char*>(\"%\"), %, %, nullptr, nullptr },\n",
+                name,
+                accessors.get ? w.write_temp("(getter)@_%", type.TypeName(), accessors.get.Name()) : "nullptr",
+                accessors.set ? w.write_temp("(setter)@_set_%", type.TypeName(), name) : "nullptr");
+        }
+
+        w.write("    { nullptr }\n};\n");
+    }
+
     void write_type_slot_table(writer& w, TypeDef const& type)
     {
         auto category = get_category(type);
@@ -208,9 +251,24 @@ namespace xlang
 
         w.write("    { Py_tp_new, @_new },\n", type.TypeName());
 
+        if (has_buffer(type))
+        {
+            w.write("#if PY_VERSION_HEX >= 0x03090000\n    { Py_bf_getbuffer, @_getbuffer },\n#endif\n", type.TypeName());
+        }
+
+        if (is_iterable(type))
+        {
+            w.write("    { Py_tp_iter, @_iter },\n", type.TypeName());
+        }
+
         if ((category == category::class_type) || (category == category::interface_type))
         {
             w.write("    { Py_tp_methods, @_methods },\n", type.TypeName());
+
+            if (!get_instance_properties(get_methods(type)).empty())
+            {
+                w.write("    { Py_tp_getset, @_getset },\n", type.TypeName());
+            }
         }
 
         if (category == category::struct_type)
@@ -302,13 +360,13 @@ static PyType_Spec @_Type_spec =
             w.write("            % param% { % };\n", param.second->Type(), sequence, bind<write_out_param_init>(param));
             break;
         case param_category::pass_array:
-            w.write("            /*p*/ winrt::array_view<% const> param% { }; // TODO: Convert incoming python parameter\n", param.second->Type(), sequence);
+            w.write("            py::pass_array<%> param%{ py::get_arg(args, %) };\n", param.second->Type(), sequence, sequence);
             break;
         case param_category::fill_array:
-            w.write("            /*f*/ winrt::array_view<%> param% { }; // TODO: Convert incoming python parameter\n", param.second->Type(), sequence);
+            w.write("            py::fill_array<%> param%{ py::get_arg(args, %) };\n", param.second->Type(), sequence, sequence);
             break;
         case param_category::receive_array:
-            w.write("            /*r*/ winrt::com_array<%> param% { };\n", param.second->Type(), sequence);
+            w.write("            winrt::com_array<%> param% { };\n", param.second->Type(), sequence);
             break;
         default:
             throw_invalid("write_param_conversion not impl");
@@ -317,7 +375,11 @@ static PyType_Spec @_Type_spec =
 
     void write_method_overload_return(writer& w, method_signature const& signature)
     {
-        if (signature.return_signature())
+        if (get_param_category(signature.return_signature()) == param_category::receive_array)
+        {
+            w.write("winrt::com_array<%> return_value = ", signature.return_signature().Type());
+        }
+        else if (signature.return_signature())
         {
             w.write("% return_value = ", signature.return_signature().Type());
         }
@@ -364,14 +426,6 @@ static PyType_Spec @_Type_spec =
     {
         auto guard{ w.push_generic_params(info.type_arguments) };
 
-        if (get_param_category(signature.return_signature()) == param_category::receive_array)
-        {
-            w.write(R"(        // returning a ReceiveArray not impl
-        return nullptr;
-)");
-            return;
-        }
-
         w.write("        try\n        {\n");
         for (auto&& param : signature.params())
         {
@@ -389,6 +443,14 @@ static PyType_Spec @_Type_spec =
             get_cpp_method_name(info.method),
             bind_list<write_param_name>(", ", signature.params()));
 
+        for (auto&& param : signature.params())
+        {
+            if (get_param_category(param) == param_category::fill_array)
+            {
+                w.write("            param%.write_back();\n", param.first.Sequence() - 1);
+            }
+        }
+
         if (signature.return_signature())
         {
             if (count_out_param(signature.params()) == 0)
@@ -440,6 +502,17 @@ static PyType_Spec @_Type_spec =
                 w.write("            return PyTuple_Pack(%, out_return_value%);\n", out_param_count, tuple_pack_param);
             }
         }
+        else if (count_out_param(signature.params()) == 1)
+        {
+            // e.g. IPropertyValue::GetInt32Array, which returns its array through an out param
+            for (auto&& param : signature.params())
+            {
+                if (is_out_param(param))
+                {
+                    w.write("\n            return py::convert(param%);\n", param.first.Sequence() - 1);
+                }
+            }
+        }
         else
         {
             w.write("            Py_RETURN_NONE;\n");
@@ -456,9 +529,9 @@ static PyType_Spec @_Type_spec =
     template <auto F>
     void write_method_overload(writer& w, TypeDef const& type, std::vector<method_info> const& overloads)
     {
-        F(w, type, overloads[0]);
+        F(w, type, overloads);
 
-        if (overloads.size() == 1 && overloads[0].method.SpecialName())
+        if (!is_fastcall(overloads))
         {
             auto overload = overloads[0];
 
@@ -477,8 +550,6 @@ static PyType_Spec @_Type_spec =
         }
         else
         {
-            w.write("    Py_ssize_t arg_count = PyTuple_Size(args);\n\n");
-
             bool first{ true };
             for (auto&& overload : overloads)
             {
@@ -503,11 +574,7 @@ static PyType_Spec @_Type_spec =
                 w.write("    }\n");
             }
 
-            w.write(R"(    else if (arg_count == -1)
-    {
-        return nullptr; 
-    }
-
+            w.write(R"(
     PyErr_SetString(PyExc_TypeError, "Invalid parameter count");
     return nullptr;
 )");
@@ -562,12 +629,22 @@ static PyObject* %__from(PyObject* /*unused*/, PyObject* arg)
         }
     }
 
-    void write_type_function_decl(writer& w, TypeDef const& type, method_info const& info)
+    void write_type_function_decl(writer& w, TypeDef const& type, std::vector<method_info> const& overloads)
     {
-        w.write("\nstatic PyObject* @_%(%, PyObject* args)\n{ \n",
-            type.TypeName(),
-            info.method.Name(),
-            bind<write_type_method_decl_self_type>(type, info.method));
+        if (is_fastcall(overloads))
+        {
+            w.write("\nstatic PyObject* @_%(%, PYWINRT_FASTCALL_PARAMS)\n{\n    PYWINRT_FASTCALL_CHECK_KWNAMES;\n\n",
+                type.TypeName(),
+                overloads[0].method.Name(),
+                bind<write_type_method_decl_self_type>(type, overloads[0].method));
+        }
+        else
+        {
+            w.write("\nstatic PyObject* @_%(%, PyObject* args)\n{ \n",
+                type.TypeName(),
+                overloads[0].method.Name(),
+                bind<write_type_method_decl_self_type>(type, overloads[0].method));
+        }
     }
 
     void write_type_functions(writer& w, TypeDef const& type)
@@ -576,8 +653,8 @@ static PyObject* %__from(PyObject* /*unused*/, PyObject* arg)
         {
             for (auto&&[name, overloads] : get_methods(type))
             {
-                write_type_function_decl(w, type, overloads[0]);
-                w.write("    return self->obj->%(args);\n}\n", name);
+                write_type_function_decl(w, type, overloads);
+                w.write("    return self->obj->%(%);\n}\n", name, is_fastcall(overloads) ? "args, arg_count" : "args");
             }
         }
         else
@@ -612,12 +689,20 @@ static PyObject* %__from(PyObject* /*unused*/, PyObject* arg)
 
         static PyTypeObject* get_python_type()
         {
+            // On failure the namespace init leaves its Python error set, for the caller to propagate.
+            if (python_type == nullptr && ::%() != 0)
+            {
+                return nullptr;
+            }
+
             return python_type;
         }
     };
 
 )";
-        w.write(format, bind<write_winrt_type_specialization_native_type>(type));
+        w.write(format,
+            bind<write_winrt_type_specialization_native_type>(type),
+            bind<write_ns_init_function_name>(type.TypeNamespace()));
     }
 
     void write_winrt_type_specialization_storage(writer& w, TypeDef const& type)
@@ -718,14 +803,47 @@ static PyObject* %__from(PyObject* /*unused*/, PyObject* arg)
         auto format = R"(
 static void @_dealloc(%* self)
 {
-    auto hash_value = std::hash<winrt::Windows::Foundation::IInspectable>{}(self->obj);
-    py::wrapped_instance(hash_value, nullptr);
+    py::remove_wrapped_instance(self);
     self->obj = nullptr;
+    py::free_wrapper(self);
+}
+)";
+        w.write(format, type.TypeName(), bind<write_winrt_wrapper>(type));
+    }
+
+    void write_type_getbuffer(writer& w, TypeDef const& type)
+    {
+        if (!has_buffer(type))
+        {
+            return;
+        }
+
+        auto format = R"(
+static int @_getbuffer(%* self, Py_buffer* view, int flags)
+{
+    return py::get_buffer(reinterpret_cast<PyObject*>(self), self->obj, view, flags);
 }
 )";
         w.write(format, type.TypeName(), bind<write_winrt_wrapper>(type));
     }
 
+    void write_type_iter(writer& w, TypeDef const& type)
+    {
+        if (!is_iterable(type))
+        {
+            return;
+        }
+
+        auto format = R"(
+static PyObject* @_iter(%* self)
+{
+    return %;
+}
+)";
+        w.write(format, type.TypeName(), bind<write_winrt_wrapper>(type),
+            is_ptype(type) ? "self->obj->iter()" : "py::iterate(self->obj)");
+    }
+
     void write_class(writer& w, TypeDef const& type)
     {
         auto guard{ w.push_generic_params(type.GenericParam()) };
@@ -734,9 +852,12 @@ static void @_dealloc(%* self)
         write_winrt_type_specialization_storage(w, type);
         write_class_constructor(w, type);
         write_class_dealloc(w, type);
+        write_type_getbuffer(w, type);
+        write_type_iter(w, type);
         write_type_query_interface(w, type);
         write_type_functions(w, type);
         write_method_table(w, type);
+        write_property_table(w, type);
         write_type_slot_table(w, type);
         write_type_spec(w, type);
     }
@@ -757,6 +878,11 @@ static void @_dealloc(%* self)
 
 
 
+    void write_pinterface_method_params(writer& w, std::vector<method_info> const& overloads)
+    {
+        w.write(is_fastcall(overloads) ? "PyObject* const* args, Py_ssize_t arg_count" : "PyObject* args");
+    }
+
     void write_pinterface_decl(writer& w, TypeDef const& type)
     {
         if (!is_ptype(type))
@@ -767,19 +893,25 @@ static void @_dealloc(%* self)
         w.write("\nstruct py@\n{\n", type.TypeName());
         w.write("    virtual ~py@() {};\n", type.TypeName());
         w.write("    virtual winrt::Windows::Foundation::IUnknown const& get_unknown() = 0;\n");
-        w.write("    virtual std::size_t hash() = 0;\n\n");
+
+        if (is_iterable(type))
+        {
+            w.write("    virtual PyObject* iter() = 0;\n");
+        }
+
+        w.write("\n");
             
         for (auto&& [method_name, overloads] : get_methods(type))
         {
-            w.write("    virtual PyObject* %(PyObject* args) = 0;\n", method_name);
+            w.write("    virtual PyObject* %(%) = 0;\n", method_name, bind<write_pinterface_method_params>(overloads));
         }
 
         w.write("};\n");
     }
 
-    void write_pinterface_method_decl(writer& w, TypeDef const&, method_info const& info)
+    void write_pinterface_method_decl(writer& w, TypeDef const&, std::vector<method_info> const& overloads)
     {
-        w.write("\nPyObject* %(PyObject* args) override\n{\n", info.method.Name());
+        w.write("\nPyObject* %(%) override\n{\n", overloads[0].method.Name(), bind<write_pinterface_method_params>(overloads));
     }
 
     void write_pinterface_impl(writer& w, TypeDef const& type)
@@ -793,7 +925,11 @@ static void @_dealloc(%* self)
 
         w.write("py@Impl(%<%> o) : obj(o) {}\n", type.TypeName(), type, bind_list<write_pinterface_type_arg_name>(", ", type.GenericParam()));
         w.write("winrt::Windows::Foundation::IUnknown const& get_unknown() override { return obj; }\n");
-        w.write("std::size_t hash() override { return py::get_instance_hash(obj); }\n");
+
+        if (is_iterable(type))
+        {
+            w.write("PyObject* iter() override { return py::iterate(obj); }\n");
+        }
 
         write_methods<write_pinterface_method_decl>(w, type);
 
@@ -843,15 +979,12 @@ PyObject* @_new(PyTypeObject* type, PyObject* args, PyObject* kwds)
         auto format = R"(
 static void @_dealloc(%* self)
 {
-    auto hash_value = %;
-    py::wrapped_instance(hash_value, nullptr);
+    py::remove_wrapped_instance(self);
     self->obj%;
+    py::free_wrapper(self);
 }
 )";
         w.write(format, type.TypeName(), bind<write_winrt_wrapper>(type), 
-            is_ptype(type)
-            ? "self->obj->hash()"
-            : "std::hash<winrt::Windows::Foundation::IInspectable>{}(self->obj)",
             is_ptype(type) ? ".release()" : " = nullptr");
     }
 
@@ -880,9 +1013,12 @@ static void @_dealloc(%* self)
         write_winrt_type_specialization_storage(w, type);
         write_interface_constructor(w, type);
         write_interface_dealloc(w, type);
+        write_type_getbuffer(w, type);
+        write_type_iter(w, type);
         write_type_query_interface(w, type);
         write_type_functions(w, type);
         write_method_table(w, type);
+        write_property_table(w, type);
         write_type_slot_table(w, type);
         write_type_spec(w, type);
     }
@@ -1001,6 +1137,17 @@ static void @_dealloc(%* self)
         return std::move(name);
     }
 
+    // Python objects supporting the buffer protocol are accepted wherever an IBuffer is; see py::buffer_converter.
+    void write_buffer_converter_decl(writer& w, TypeDef const& type)
+    {
+        if (type.TypeNamespace() != "Windows.Storage.Streams" || type.TypeName() != "IBuffer")
+        {
+            return;
+        }
+
+        w.write_indented("template<>\nstruct converter<%> : buffer_converter<%>\n{\n};\n\n", type, type);
+    }
+
     void write_struct_converter_decl(writer& w, TypeDef const& type)
     {
         w.write_indented("template<>\nstruct converter<%>\n{\n", type);
@@ -1033,7 +1180,7 @@ static void @_dealloc(%* self)
         {
             writer::indent_guard g{ w };
             w.write_indented("throw_if_pyobj_null(obj);\n");
-            w.write_indented(R"(if (Py_TYPE(obj) == py::get_python_type<%>())
+            w.write_indented(R"(if (Py_TYPE(obj) == py::get_checked_python_type<%>())
 {
     return reinterpret_cast<py::winrt_struct_wrapper<%>*>(obj)->obj;
 }
@@ -1463,41 +1610,80 @@ static int @_set_%(%* self, PyObject* value, void* /*unused*/)
             ? w.write_temp("py@", type.TypeName())
             : w.write_temp("%", type);
 
-        if (has_dealloc(type))
-        {
-            w.write_indented("\ntype_object = PyType_FromSpecWithBases(&@_Type_spec, bases);\n", type.TypeName());
-        }
-        else
+        // Types created by an earlier, partly failed call are kept, so a retry neither leaks them nor replaces a
+        // type that live instances already point to.
+        w.write_indented("\nif (py::winrt_type<%>::python_type == nullptr)\n{\n", winrt_type_param);
         {
-            w.write_indented("\ntype_object = PyType_FromSpec(&@_Type_spec);\n", type.TypeName());
-        }
+            writer::indent_guard g{ w };
 
+            if (has_dealloc(type))
+            {
+                w.write_indented("type_object = PyType_FromSpecWithBases(&@_Type_spec, bases);\n", type.TypeName());
+            }
+            else
+            {
+                w.write_indented("type_object = PyType_FromSpec(&@_Type_spec);\n", type.TypeName());
+            }
 
-        auto format = R"(if (type_object == nullptr)
+            auto format = R"(if (type_object == nullptr)
 {
+    Py_DECREF(bases);
     return -1;
 }
-if (PyModule_AddObject(module, "@", type_object) != 0)
+py::winrt_type<%>::python_type = reinterpret_cast<PyTypeObject*>(type_object);
+)";
+            w.write_indented(format, winrt_type_param);
+
+            if (has_buffer(type))
+            {
+                w.write_indented("py::set_getbuffer(type_object, reinterpret_cast<getbufferproc>(@_getbuffer));\n", type.TypeName());
+            }
+        }
+        w.write_indented("}\n");
+    }
+
+    void write_type_add(writer& w, TypeDef const& type)
+    {
+        if (is_exclusive_to(type))
+        {
+            return;
+        }
+
+        auto winrt_type_param = is_ptype(type)
+            ? w.write_temp("py@", type.TypeName())
+            : w.write_temp("%", type);
+
+        auto format = R"(
+if (py::add_type(module, "@", py::winrt_type<%>::python_type) != 0)
 {
-    Py_DECREF(type_object);
     return -1;
 }
-py::winrt_type<%>::python_type = reinterpret_cast<PyTypeObject*>(type_object);
-type_object = nullptr;
 )";
-        w.write_indented(format,
-            type.TypeName(),
-            winrt_type_param);
+        w.write_indented(format, type.TypeName(), winrt_type_param);
     }
 
     void write_namespace_init(writer& w, filter const& f, std::string_view const& ns, cache::namespace_members const& members)
     {
         w.write("\n// ----- % Initialization --------------------\n", ns);
+
+        // The namespace's types are created the first time one of them is needed, either natively, by
+        // py::get_python_type, or by the namespace's module being imported, rather than when the package is.
         auto format = R"(
-int %(PyObject* module)
+static bool types_initialized{};
+
+int %()
 {
+    if (types_initialized)
+    {
+        return 0;
+    }
+
     PyObject* type_object{ nullptr };
     PyObject* bases = PyTuple_Pack(1, py::winrt_type<py::winrt_base>::python_type);
+    if (bases == nullptr)
+    {
+        return -1;
+    }
 )";
 
         w.write_indented(format, bind<write_ns_init_function_name>(ns));
@@ -1510,14 +1696,35 @@ int %(PyObject* module)
 
             w.write_indented(R"(
 Py_DECREF(bases);
+types_initialized = true;
 return 0;
 )");
         }
         w.write_indented("}\n");
 
+        format = R"(
+static int module_exec(PyObject* module)
+{
+    if (%() != 0)
+    {
+        return -1;
+    }
+)";
+        w.write_indented(format, bind<write_ns_init_function_name>(ns));
+        {
+            writer::indent_guard g{ w };
+
+            f.bind_each<write_type_add>(members.classes)(w);
+            f.bind_each<write_type_add>(members.interfaces)(w);
+            f.bind_each<write_type_add>(members.structs)(w);
+
+            w.write_indented("\nreturn 0;\n");
+        }
+        w.write_indented("}\n");
+
         format = R"(
 static PyModuleDef_Slot module_slots[] = {
-    {Py_mod_exec, %},
+    {Py_mod_exec, module_exec},
     {0, nullptr}
 };
 
@@ -1543,7 +1750,7 @@ PyInit_%(void)
 )";
         auto segments = get_dotted_name_segments(ns);
         auto module_name = w.write_temp("_%_%", settings.module, bind_list("_", segments));
-        w.write_indented(format, bind<write_ns_init_function_name>(ns), module_name, module_name);
+        w.write_indented(format, module_name, module_name);
     }
 
 
@@ -1574,6 +1781,33 @@ static int module_exec(PyObject* module)
     py::winrt_type<py::winrt_base>::python_type = reinterpret_cast<PyTypeObject*>(type_object);
     type_object = nullptr;
 
+    type_object = PyType_FromSpec(&array_buffer_Type_spec);
+    if (type_object == nullptr)
+    {
+        return -1;
+    }
+    py::set_getbuffer(type_object, reinterpret_cast<getbufferproc>(array_buffer_getbuffer));
+    if (PyModule_AddObject(module, "_winrt_array", type_object) != 0)
+    {
+        Py_DECREF(type_object);
+        return -1;
+    }
+    py::winrt_type<py::array_buffer>::python_type = reinterpret_cast<PyTypeObject*>(type_object);
+    type_object = nullptr;
+
+    type_object = PyType_FromSpec(&winrt_iterator_Type_spec);
+    if (type_object == nullptr)
+    {
+        return -1;
+    }
+    if (PyModule_AddObject(module, "_winrt_iterator", type_object) != 0)
+    {
+        Py_DECREF(type_object);
+        return -1;
+    }
+    py::winrt_type<py::winrt_iterator>::python_type = reinterpret_cast<PyTypeObject*>(type_object);
+    type_object = nullptr;
+
 )";
             w.write(format);
         }
@@ -29,6 +29,8 @@ namespace xlang
         f.bind_each<write_pinterface_decl>(members.interfaces)(w);
         f.bind_each<write_pinterface_impl>(members.interfaces)(w);
 
+        w.write("\nint %();\n", bind<write_ns_init_function_name>(ns));
+
         w.write("\nnamespace py\n{\n");
         {
             writer::indent_guard g{ w };
@@ -36,6 +38,7 @@ namespace xlang
             f.bind_each<write_winrt_type_specialization>(members.interfaces)(w);
             f.bind_each<write_winrt_type_specialization>(members.structs)(w);
             f.bind_each<write_struct_converter_decl>(members.structs)(w);
+            f.bind_each<write_buffer_converter_decl>(members.interfaces)(w);
             f.bind_each<write_pinterface_type_mapper>(members.interfaces)(w);
             f.bind_each<write_delegate_type_mapper>(members.delegates)(w);
         }
@@ -120,32 +123,48 @@ namespace xlang
         w.flush_to_file(folder / "__init__.py");
     }
 
-    inline void write_namespace_init(stdfs::path const& folder, std::string_view const& module_name, std::set<std::string> const& needed_namespaces, std::string_view const& ns, cache::namespace_members const& members)
+    inline void write_namespace_init(stdfs::path const& folder, std::string_view const& module_name, cache const& c, std::string_view const& ns, cache::namespace_members const& members)
     {
         writer w;
+        xlang::filter f{ settings.include, settings.exclude };
 
-        w.write(strings::ns_init, module_name, ns);
-
-        if (!needed_namespaces.empty())
+        auto type_names = [&](writer& w)
+        {
+            f.bind_each<write_import_type_name>(members.classes)(w);
+            f.bind_each<write_import_type_name>(members.interfaces)(w);
+            f.bind_each<write_import_type_name>(members.structs)(w);
+        };
+
+        // The generated namespaces nested in this one, other than those nested in another of them, which imports
+        // them itself. A nested namespace without types of its own has no folder, so its children are listed here.
+        auto child_namespaces = [&](writer& w)
         {
-            for (auto&& needed_ns : needed_namespaces)
+            std::string const prefix = std::string{ ns } + ".";
+            std::vector<std::string_view> children;
+
+            for (auto&&[child, child_members] : c.namespaces())
             {
-                auto ns = needed_ns;
-                std::transform(ns.begin(), ns.end(), ns.begin(), [](char c) {return static_cast<char>(::tolower(c)); });
-                auto format = R"(try:
-    import %.%
-except:
-    pass
-)";
-                w.write_indented(format, module_name, ns);
+                if (child.size() <= prefix.size() || child.substr(0, prefix.size()) != prefix || !f.includes(child_members))
+                {
+                    continue;
+                }
+
+                if (std::any_of(children.begin(), children.end(), [&](std::string_view const& parent)
+                    {
+                        return child.size() > parent.size() && child.substr(0, parent.size()) == parent && child[parent.size()] == '.';
+                    }))
+                {
+                    continue;
+                }
+
+                children.push_back(child);
+                std::string name{ child.substr(prefix.size()) };
+                std::transform(name.begin(), name.end(), name.begin(), [](char value) {return static_cast<char>(::tolower(value)); });
+                w.write("    \"%\",\n", name);
             }
-            w.write("\n");
-        }
+        };
 
-        xlang::filter f{ settings.include, settings.exclude };
-        f.bind_each<write_import_type>(members.classes)(w);
-        f.bind_each<write_import_type>(members.interfaces)(w);
-        f.bind_each<write_import_type>(members.structs)(w);
+        w.write(strings::ns_init, module_name, type_names, child_namespaces, ns);
 
         create_directories(folder);
         w.flush_to_file(folder / "__init__.py");
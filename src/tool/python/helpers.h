@@ -523,12 +523,91 @@ namespace xlang
         return { add_method, remove_method };
     }
 
+    // Property accessors and event handlers take exactly one argument, or none, and get METH_NOARGS or METH_O.
+    // Everything else gets METH_FASTCALL, which passes the arguments as an array rather than packing them into a
+    // tuple.
+    bool is_fastcall(std::vector<method_info> const& overloads)
+    {
+        return overloads.size() != 1 || !overloads[0].method.SpecialName();
+    }
+
+    // Instance properties, by name, whose accessors are also exposed through the type's PyGetSetDef table.
+    auto get_instance_properties(std::map<std::string_view, std::vector<method_info>> const& methods)
+    {
+        std::map<std::string_view, property_type> properties;
+
+        for (auto&&[name, overloads] : methods)
+        {
+            if (is_fastcall(overloads) || overloads[0].method.Flags().Static())
+            {
+                continue;
+            }
+
+            auto method = overloads[0].method;
+            auto property_name = name.substr(name.find('_') + 1);
+
+            if (methods.find(property_name) != methods.end())
+            {
+                continue;
+            }
+
+            if (is_get_method(method))
+            {
+                properties[property_name].get = method;
+            }
+            else if (is_put_method(method))
+            {
+                properties[property_name].set = method;
+            }
+        }
+
+        return std::move(properties);
+    }
+
     bool has_dealloc(TypeDef const& type)
     {
         auto category = get_category(type);
         return category == category::interface_type || (category == category::class_type && !type.Flags().Abstract());
     }
 
+    // Wrappers of types implementing IBuffer expose the buffer's bytes through the Python buffer protocol.
+    bool has_buffer(TypeDef const& type)
+    {
+        if (!has_dealloc(type) || is_ptype(type))
+        {
+            return false;
+        }
+
+        for (auto&& info : get_required_interfaces(type))
+        {
+            if (info.type.TypeNamespace() == "Windows.Storage.Streams" && info.type.TypeName() == "IBuffer")
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Wrappers of types implementing IIterable support Python iteration; see py::iterate.
+    bool is_iterable(TypeDef const& type)
+    {
+        if (!has_dealloc(type))
+        {
+            return false;
+        }
+
+        for (auto&& info : get_required_interfaces(type))
+        {
+            if (info.type.TypeNamespace() == "Windows.Foundation.Collections" && info.type.TypeName() == "IIterable`1")
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
     enum class param_category
     {
         in,
@@ -133,7 +133,7 @@ namespace xlang
                 {
                     auto namespaces = write_namespace_cpp(src_dir, ns, members);
                     write_namespace_h(src_dir, ns, namespaces, members);
-                    write_namespace_init(ns_dir, settings.module, namespaces, ns, members);
+                    write_namespace_init(ns_dir, settings.module, c, ns, members);
                 });
             }
 
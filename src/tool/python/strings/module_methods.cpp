@@ -18,38 +18,168 @@ static PyType_Spec winrt_base_Type_spec =
     winrt_base_Type_slots
 };
 
-std::unordered_map<std::size_t, PyObject*> instance_map{};
-
-void py::wrapped_instance(std::size_t key, PyObject* obj)
-{
-    // TODO: re-enable instance wrapper caching 
-
-    // if obj is null, remove from instance_map
-    //if (obj)
-    //{
-    //    auto insert = instance_map.try_emplace(key, obj);
-
-    //    if (insert.second == false)
-    //    {
-    //        throw winrt::hresult_invalid_argument(L"wrapped WinRT object already cached");
-    //    }
-    //}
-    //else
-    //{
-    //    // TODO: clean up the wrapped WinRT object. Currently leaking
-    //    instance_map.extract(key);
-    //}
+PyTypeObject* py::winrt_type<py::array_buffer>::python_type;
+
+static void array_buffer_dealloc(py::array_buffer* self)
+{
+    WINRT_CoTaskMemFree(self->data);
+
+    auto type = Py_TYPE(self);
+    type->tp_free(self);
+#if PY_VERSION_HEX >= 0x03080000
+    Py_DECREF(type);
+#endif
+}
+
+static int array_buffer_getbuffer(py::array_buffer* self, Py_buffer* view, int flags)
+{
+    view->obj = reinterpret_cast<PyObject*>(self);
+    Py_INCREF(self);
+    view->buf = self->data;
+    view->len = self->count * self->itemsize;
+    view->readonly = 0;
+    view->itemsize = self->itemsize;
+    view->format = (flags & PyBUF_FORMAT) ? const_cast<char*>(self->format) : nullptr;
+    view->ndim = 1;
+    view->shape = (flags & PyBUF_ND) ? &self->count : nullptr;
+    view->strides = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) ? &self->itemsize : nullptr;
+    view->suboffsets = nullptr;
+    view->internal = nullptr;
+    return 0;
+}
+
+PyDoc_STRVAR(array_buffer_doc, "array received from a WinRT method, read through a memoryview.");
+
+static PyType_Slot array_buffer_Type_slots[] =
+{
+    { Py_tp_doc, array_buffer_doc },
+    { Py_tp_dealloc, array_buffer_dealloc },
+#if PY_VERSION_HEX >= 0x03090000
+    { Py_bf_getbuffer, array_buffer_getbuffer },
+#endif
+    { 0, nullptr },
+};
+
+static PyType_Spec array_buffer_Type_spec =
+{
+    "_winrt_array",
+    sizeof(py::array_buffer),
+    0,
+    Py_TPFLAGS_DEFAULT,
+    array_buffer_Type_slots
+};
+
+PyTypeObject* py::winrt_type<py::winrt_iterator>::python_type;
+
+uint32_t py::iterator_batch_size{ 64 };
+
+static void winrt_iterator_dealloc(py::winrt_iterator* self)
+{
+    delete self->source;
+
+    auto type = Py_TYPE(self);
+    type->tp_free(self);
+#if PY_VERSION_HEX >= 0x03080000
+    Py_DECREF(type);
+#endif
+}
+
+static PyObject* winrt_iterator_next(py::winrt_iterator* self)
+{
+    return self->source->next();
+}
+
+PyDoc_STRVAR(winrt_iterator_doc, "iterator over a WinRT collection.");
+
+static PyType_Slot winrt_iterator_Type_slots[] =
+{
+    { Py_tp_doc, winrt_iterator_doc },
+    { Py_tp_dealloc, winrt_iterator_dealloc },
+    { Py_tp_iter, PyObject_SelfIter },
+    { Py_tp_iternext, winrt_iterator_next },
+    { 0, nullptr },
+};
+
+static PyType_Spec winrt_iterator_Type_spec =
+{
+    "_winrt_iterator",
+    sizeof(py::winrt_iterator),
+    0,
+    Py_TPFLAGS_DEFAULT,
+    winrt_iterator_Type_slots
+};
+
+namespace
+{
+    struct instance_key_hash
+    {
+        std::size_t operator()(std::pair<void*, PyTypeObject*> const& key) const noexcept
+        {
+            return std::hash<void*>{}(key.first) ^ (std::hash<void*>{}(key.second) << 1);
+        }
+    };
+
+    std::mutex instance_lock;
+    std::unordered_map<std::pair<void*, PyTypeObject*>, PyObject*, instance_key_hash> instance_map;
 }
 
-PyObject* py::wrapped_instance(std::size_t key)
+PyObject* py::find_wrapped_instance(void* identity, PyTypeObject* type) noexcept
 {
-    //auto const it = instance_map.find(key);
-    //if (it == instance_map.end())
+    std::lock_guard<std::mutex> guard{ instance_lock };
+    auto const it = instance_map.find({ identity, type });
+
+    if (it == instance_map.end())
     {
         return nullptr;
     }
 
-    //return it->second;
+    Py_INCREF(it->second);
+    return it->second;
+}
+
+PyObject* py::add_wrapped_instance(winrt_wrapper_base* obj) noexcept
+{
+    auto wrapper = reinterpret_cast<PyObject*>(obj);
+    PyObject* cached{};
+
+    {
+        std::lock_guard<std::mutex> guard{ instance_lock };
+
+        try
+        {
+            auto const [it, inserted] = instance_map.try_emplace({ obj->identity, Py_TYPE(wrapper) }, wrapper);
+
+            if (inserted)
+            {
+                return wrapper;
+            }
+
+            cached = it->second;
+            Py_INCREF(cached);
+        }
+        catch (...)
+        {
+            // The wrapper works just as well uncached.
+            return wrapper;
+        }
+    }
+
+    // Released outside the lock, since deallocating it removes it from the cache.
+    Py_DECREF(wrapper);
+    return cached;
+}
+
+void py::remove_wrapped_instance(winrt_wrapper_base* obj) noexcept
+{
+    auto wrapper = reinterpret_cast<PyObject*>(obj);
+    std::lock_guard<std::mutex> guard{ instance_lock };
+    auto const it = instance_map.find({ obj->identity, Py_TYPE(wrapper) });
+
+    // Another wrapper may have been cached for the object, if this one never was.
+    if (it != instance_map.end() && it->second == wrapper)
+    {
+        instance_map.erase(it);
+    }
 }
 
 static PyObject* init_apartment(PyObject* /*unused*/, PyObject* /*unused*/)
@@ -64,8 +194,28 @@ static PyObject* uninit_apartment(PyObject* /*unused*/, PyObject* /*unused*/)
     Py_RETURN_NONE;
 }
 
+static PyObject* set_iterator_batch_size(PyObject* /*unused*/, PyObject* arg)
+{
+    auto size = PyLong_AsUnsignedLong(arg);
+
+    if (size == static_cast<unsigned long>(-1) && PyErr_Occurred())
+    {
+        return nullptr;
+    }
+
+    if (size == 0)
+    {
+        PyErr_SetString(PyExc_ValueError, "batch size must be at least 1");
+        return nullptr;
+    }
+
+    py::iterator_batch_size = size;
+    Py_RETURN_NONE;
+}
+
 static PyMethodDef module_methods[]{
     { "init_apartment", init_apartment, METH_NOARGS, "initialize the apartment" },
     { "uninit_apartment", uninit_apartment, METH_NOARGS, "uninitialize the apartment" },
+    { "set_iterator_batch_size", set_iterator_batch_size, METH_O, "set how many elements iterating a WinRT collection fetches at a time" },
     { nullptr }
 };
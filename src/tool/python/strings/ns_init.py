@@ -1,6 +1,47 @@
 # WARNING: Please don't edit this file. It was generated by Python/WinRT
 
+import importlib
+import sys
 from % import _import_ns
 
-_internal = _import_ns("%")
+# The namespace's types are created the first time one of them is used, rather than when it's imported (PEP 562).
+_type_names = frozenset([
+%])
 
+# Namespaces nested in this one, which Python 3.7 and later import on first access instead
+_child_namespaces = [
+%]
+
+_internal = None
+
+def __getattr__(name):
+    global _internal
+
+    if name not in _type_names:
+        # Child namespaces, such as windows.foundation.collections, are packages of their own. They are imported on
+        # first access, since importing this namespace no longer imports the ones its types refer to.
+        if not name.startswith("_"):
+            try:
+                return importlib.import_module("." + name, __name__)
+            except ModuleNotFoundError as e:
+                if e.name != __name__ + "." + name:
+                    raise
+        raise AttributeError("module '{}' has no attribute '{}'".format(__name__, name))
+
+    if _internal is None:
+        _internal = _import_ns("%")
+
+    value = getattr(_internal, name)
+    globals()[name] = value
+    return value
+
+def __dir__():
+    return sorted(set(globals()) | _type_names)
+
+# Module __getattr__ needs Python 3.7. Before that, the namespace's types and child namespaces are loaded up front.
+if sys.version_info < (3, 7):
+    for _name in _type_names:
+        __getattr__(_name)
+
+    for _name in _child_namespaces:
+        importlib.import_module("." + _name, __name__)
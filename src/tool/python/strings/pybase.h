@@ -6,8 +6,31 @@
 #include <Python.h>
 #include <structmember.h>
 
+#include <mutex>
+#include <unordered_map>
+
+// IBufferByteAccess is a COM interface rather than a WinRT one; winrt::implements supports those when unknwn.h is
+// included ahead of winrt/base.h.
+#include <unknwn.h>
+#include <robuffer.h>
+
 #include <winrt/base.h>
 
+// Generated methods taking positional arguments use METH_FASTCALL, which passes them as an array rather than packing
+// them into a tuple. Python 3.6 also passes the names of any keyword arguments, which aren't supported.
+#if PY_VERSION_HEX >= 0x03070000
+#define PYWINRT_FASTCALL_PARAMS PyObject* const* args, Py_ssize_t arg_count
+#define PYWINRT_FASTCALL_CHECK_KWNAMES
+#else
+#define PYWINRT_FASTCALL_PARAMS PyObject** args, Py_ssize_t arg_count, PyObject* kwnames
+#define PYWINRT_FASTCALL_CHECK_KWNAMES \
+    if (kwnames != nullptr && PyTuple_GET_SIZE(kwnames) != 0) \
+    { \
+        PyErr_SetString(PyExc_TypeError, "keyword arguments not supported"); \
+        return nullptr; \
+    }
+#endif
+
 namespace winrt::impl
 {
     // Bug 19167653: C++/WinRT missing category for AsyncStatus and CollectionChange. 
@@ -85,6 +108,9 @@ namespace py
 
         // PyObject_New doesn't call type's constructor, so manually manage the "virtual" get_unknown function
         winrt::Windows::Foundation::IUnknown const&(*get_unknown)(winrt_wrapper_base* self);
+
+        // The wrapped object's IUnknown pointer, which the wrapper is cached under. Not a reference.
+        void* identity;
     };
 
     template<typename T>
@@ -116,6 +142,34 @@ namespace py
         }
     };
 
+    // Owns an array received from WinRT and exposes its memory through the buffer protocol, so Python reads it in
+    // place. Only used for arrays of buffer_format element types, which need no destruction.
+    struct array_buffer
+    {
+        PyObject_HEAD;
+        void* data;
+        Py_ssize_t count;
+        Py_ssize_t itemsize;
+        char const* format;
+    };
+
+    // Python iterator over a WinRT collection; see iterate.
+    struct iterator_source
+    {
+        virtual ~iterator_source() = default;
+        virtual PyObject* next() noexcept = 0;
+    };
+
+    struct winrt_iterator
+    {
+        PyObject_HEAD;
+        iterator_source* source;
+    };
+
+    // How many elements iterating a WinRT collection fetches per GetMany call. Set with
+    // _pyrt.set_iterator_batch_size.
+    extern uint32_t iterator_batch_size;
+
     template<typename To>
     To as(winrt_wrapper_base* wrapper)
     {
@@ -139,6 +193,18 @@ namespace py
         static PyTypeObject* python_type;
     };
 
+    template<>
+    struct winrt_type<array_buffer>
+    {
+        static PyTypeObject* python_type;
+    };
+
+    template<>
+    struct winrt_type<winrt_iterator>
+    {
+        static PyTypeObject* python_type;
+    };
+
     template<typename T>
     PyTypeObject* get_python_type()
     {
@@ -152,12 +218,54 @@ namespace py
         }
     }
 
+    // Thrown when the Python error to report is already set, which to_PyErr then leaves in place.
+    struct python_exception : std::exception
+    {
+        char const* what() const noexcept override
+        {
+            return "a Python exception was raised";
+        }
+    };
+
+    // get_python_type returns null with an error set when the type's namespace failed to initialize; converters
+    // raise that error rather than reporting the argument as having the wrong type.
+    template<typename T>
+    PyTypeObject* get_checked_python_type()
+    {
+        PyTypeObject* type_object = get_python_type<T>();
+
+        if (type_object == nullptr && PyErr_Occurred())
+        {
+            throw python_exception{};
+        }
+
+        return type_object;
+    }
+
+    // Adds one of a namespace's types to its module. The type is created, and kept alive, by the namespace's
+    // initialize function, so the module takes a reference of its own.
+    inline int add_type(PyObject* module, char const* name, PyTypeObject* type) noexcept
+    {
+        Py_INCREF(type);
+
+        if (PyModule_AddObject(module, name, reinterpret_cast<PyObject*>(type)) != 0)
+        {
+            Py_DECREF(type);
+            return -1;
+        }
+
+        return 0;
+    }
+
     inline __declspec(noinline) PyObject* to_PyErr() noexcept
     {
         try
         {
             throw;
         }
+        catch (python_exception const&)
+        {
+        }
         catch (winrt::hresult_error const& e)
         {
             PyErr_SetString(PyExc_RuntimeError, winrt::to_string(e.message()).c_str());
@@ -182,13 +290,36 @@ namespace py
         return nullptr;
     }
 
-    void wrapped_instance(std::size_t key, PyObject* obj);
-    PyObject* wrapped_instance(std::size_t key);
+    // Wrappers of WinRT objects are cached by the object's identity and the wrapper's type, so an object that
+    // crosses into Python again gets the wrapper it already has. The cache holds no references: a wrapper stays
+    // cached until it's deallocated, which removes it. Callers hold the GIL, which is what keeps a wrapper from
+    // being found while it's being deallocated; the cache also has a lock of its own.
+
+    // Returns a new reference to the cached wrapper, or null if there isn't one.
+    PyObject* find_wrapped_instance(void* identity, PyTypeObject* type) noexcept;
 
+    // Caches a new wrapper and returns it, unless one was cached for the same object and type first, in which
+    // case the new wrapper is released and a new reference to that one returned.
+    PyObject* add_wrapped_instance(winrt_wrapper_base* obj) noexcept;
+
+    void remove_wrapped_instance(winrt_wrapper_base* obj) noexcept;
+
+    // Frees a deallocated wrapper. Since Python 3.8, instances of heap types hold a reference to their type.
+    inline void free_wrapper(winrt_wrapper_base* obj) noexcept
+    {
+        auto type = Py_TYPE(obj);
+        type->tp_free(obj);
+#if PY_VERSION_HEX >= 0x03080000
+        Py_DECREF(type);
+#endif
+    }
+
+    // The object's IUnknown pointer, which stays the same whichever interface it's reached through, for as long
+    // as the object is alive.
     template<typename T>
-    inline auto get_instance_hash(T const& instance)
+    void* get_identity(T const& instance)
     {
-        return std::hash<winrt::Windows::Foundation::IUnknown>{}(instance);
+        return winrt::get_abi(instance.template as<winrt::Windows::Foundation::IUnknown>());
     }
 
     template<typename T>
@@ -196,7 +327,11 @@ namespace py
     {
         if (type_object == nullptr)
         {
-            PyErr_SetNone(PyExc_NotImplementedError);
+            // Keep the error from a failed namespace init, if that is why the type is missing.
+            if (!PyErr_Occurred())
+            {
+                PyErr_SetNone(PyExc_NotImplementedError);
+            }
             return nullptr;
         }
 
@@ -219,10 +354,20 @@ namespace py
     {
         if (type_object == nullptr)
         {
-            PyErr_SetNone(PyExc_NotImplementedError);
+            if (!PyErr_Occurred())
+            {
+                PyErr_SetNone(PyExc_NotImplementedError);
+            }
             return nullptr;
         }
 
+        void* identity = get_identity(instance);
+
+        if (PyObject* cached = find_wrapped_instance(identity, type_object))
+        {
+            return cached;
+        }
+
         auto py_instance = PyObject_New(py::winrt_wrapper<T>, type_object);
 
         if (!py_instance)
@@ -232,12 +377,11 @@ namespace py
 
         // PyObject_New doesn't call type's constructor, so manually initialize the wrapper's fields
         py_instance->get_unknown = &winrt_wrapper<T>::fetch_unknown;
+        py_instance->identity = identity;
         std::memset(&(py_instance->obj), 0, sizeof(py_instance->obj));
         py_instance->obj = instance;
 
-        wrapped_instance(get_instance_hash(instance), reinterpret_cast<PyObject*>(py_instance));
-
-        return reinterpret_cast<PyObject*>(py_instance);
+        return add_wrapped_instance(py_instance);
     }
 
     template<typename T>
@@ -249,10 +393,20 @@ namespace py
 
         if (type_object == nullptr)
         {
-            PyErr_SetNone(PyExc_NotImplementedError);
+            if (!PyErr_Occurred())
+            {
+                PyErr_SetNone(PyExc_NotImplementedError);
+            }
             return nullptr;
         }
 
+        void* identity = get_identity(instance);
+
+        if (PyObject* cached = find_wrapped_instance(identity, type_object))
+        {
+            return cached;
+        }
+
         auto py_instance = PyObject_New(py::winrt_pinterface_wrapper<ptype::abstract>, type_object);
 
         if (!py_instance)
@@ -262,12 +416,11 @@ namespace py
 
         // PyObject_New doesn't call type's constructor, so manually initialize the wrapper's fields
         py_instance->get_unknown = &winrt_pinterface_wrapper<ptype::abstract>::fetch_unknown;
+        py_instance->identity = identity;
         std::memset(&(py_instance->obj), 0, sizeof(py_instance->obj));
         py_instance->obj = std::make_unique<ptype::concrete>(instance);
 
-        wrapped_instance(get_instance_hash(instance), reinterpret_cast<PyObject*>(py_instance));
-
-        return reinterpret_cast<PyObject*>(py_instance);
+        return add_wrapped_instance(py_instance);
     }
 
     template<typename T>
@@ -603,7 +756,7 @@ namespace py
         {
             throw_if_pyobj_null(obj);
 
-            if (Py_TYPE(obj) != get_python_type<T>())
+            if (Py_TYPE(obj) != get_checked_python_type<T>())
             {
                 throw winrt::hresult_invalid_argument();
             }
@@ -685,8 +838,15 @@ namespace py
 
             uint32_t GetMany(winrt::array_view<T> values)
             {
-                // TODO: implement GetMany
-                throw winrt::hresult_not_implemented();
+                uint32_t count{};
+
+                while (count < values.size() && _current_value.has_value())
+                {
+                    values[count++] = std::move(_current_value.value());
+                    _current_value = get_next(_iterator);
+                }
+
+                return count;
             }
         };
     };
@@ -696,7 +856,7 @@ namespace py
     {
         throw_if_pyobj_null(obj);
 
-        if (Py_TYPE(obj) == get_python_type<T>())
+        if (Py_TYPE(obj) == get_checked_python_type<T>())
         {
             return reinterpret_cast<winrt_wrapper<T>*>(obj)->obj;
         }
@@ -784,15 +944,544 @@ namespace py
         }
     };
 
+    // Arrays of these element types move between Python and WinRT through the buffer protocol rather than being
+    // converted element by element. The format is the struct module code describing one element.
+    template <typename T>
+    struct buffer_format
+    {
+        static constexpr char const* value = nullptr;
+    };
+
+    template <> struct buffer_format<bool> { static constexpr char const* value = "?"; };
+    template <> struct buffer_format<uint8_t> { static constexpr char const* value = "B"; };
+    template <> struct buffer_format<int16_t> { static constexpr char const* value = "h"; };
+    template <> struct buffer_format<uint16_t> { static constexpr char const* value = "H"; };
+    template <> struct buffer_format<char16_t> { static constexpr char const* value = "H"; };
+    template <> struct buffer_format<int32_t> { static constexpr char const* value = "i"; };
+    template <> struct buffer_format<uint32_t> { static constexpr char const* value = "I"; };
+    template <> struct buffer_format<int64_t> { static constexpr char const* value = "q"; };
+    template <> struct buffer_format<uint64_t> { static constexpr char const* value = "Q"; };
+    template <> struct buffer_format<float> { static constexpr char const* value = "f"; };
+    template <> struct buffer_format<double> { static constexpr char const* value = "d"; };
+
+    template <typename T>
+    inline constexpr bool is_buffer_element_v = buffer_format<T>::value != nullptr;
+
+    // Whether a buffer's elements can be read as T. Any integer code of the right size and signedness matches, since
+    // array.array('l') and numpy's int32 describe the same memory with different codes.
+    template <typename T>
+    bool is_buffer_of(Py_buffer const& view) noexcept
+    {
+        if (view.itemsize != sizeof(T))
+        {
+            return false;
+        }
+
+        char const* format = view.format ? view.format : "B";
+
+        if (*format == '@' || *format == '=' || *format == '<')
+        {
+            ++format;
+        }
+
+        if (format[0] == 0 || format[1] != 0)
+        {
+            return false;
+        }
+
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            return format[0] == '?';
+        }
+        else if constexpr (std::is_floating_point_v<T>)
+        {
+            return format[0] == 'f' || format[0] == 'd';
+        }
+        else if constexpr (std::is_signed_v<T>)
+        {
+            return std::strchr("bhilq", format[0]) != nullptr;
+        }
+        else
+        {
+            return std::strchr("BHILQc", format[0]) != nullptr;
+        }
+    }
+
+    // Holds a buffer obtained from a Python object until the WinRT call that uses it returns.
+    struct buffer_view
+    {
+        Py_buffer view{};
+
+        buffer_view(PyObject* obj, int flags)
+        {
+            if (PyObject_GetBuffer(obj, &view, flags) != 0)
+            {
+                throw winrt::hresult_invalid_argument();
+            }
+        }
+
+        buffer_view(buffer_view const&) = delete;
+        buffer_view& operator=(buffer_view const&) = delete;
+
+        ~buffer_view()
+        {
+            PyBuffer_Release(&view);
+        }
+    };
+
+    // A PassArray parameter. Objects supporting the buffer protocol whose elements match are passed in place;
+    // anything else, including a buffer of another element type, is read as a sequence and converted into a
+    // temporary array.
+    template <typename T>
+    struct pass_array
+    {
+        explicit pass_array(PyObject* obj)
+        {
+            throw_if_pyobj_null(obj);
+
+            if constexpr (is_buffer_element_v<T>)
+            {
+                if (PyObject_CheckBuffer(obj))
+                {
+                    m_buffer.emplace(obj, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT);
+
+                    if (is_buffer_of<T>(m_buffer->view))
+                    {
+                        m_data = static_cast<T const*>(m_buffer->view.buf);
+                        m_size = static_cast<uint32_t>(m_buffer->view.len / sizeof(T));
+                        return;
+                    }
+
+                    // Other element types, such as a numpy int64 array passed for Int32[], are converted item by
+                    // item below.
+                    m_buffer.reset();
+                }
+            }
+
+            PyObject* sequence = PySequence_Fast(obj, "expected a sequence or buffer");
+
+            if (sequence == nullptr)
+            {
+                throw winrt::hresult_invalid_argument();
+            }
+
+            Py_ssize_t const size = PySequence_Fast_GET_SIZE(sequence);
+            PyObject** items = PySequence_Fast_ITEMS(sequence);
+
+            try
+            {
+                m_values.reserve(size);
+
+                for (Py_ssize_t index = 0; index < size; ++index)
+                {
+                    m_values.emplace_back(converter<T>::convert_to(items[index]));
+                }
+            }
+            catch (...)
+            {
+                Py_DECREF(sequence);
+                throw;
+            }
+
+            Py_DECREF(sequence);
+            m_data = reinterpret_cast<T const*>(m_values.data());
+            m_size = static_cast<uint32_t>(m_values.size());
+        }
+
+        operator winrt::array_view<T const>() const noexcept
+        {
+            return { m_data, m_size };
+        }
+
+    private:
+
+        // std::vector<bool> has no data(), so bool elements are stored as bytes, which have the same layout.
+        using storage_type = std::conditional_t<std::is_same_v<T, bool>, uint8_t, T>;
+
+        std::optional<buffer_view> m_buffer;
+        std::vector<storage_type> m_values;
+        T const* m_data{};
+        uint32_t m_size{};
+    };
+
+    // A FillArray parameter, which the callee writes into. A writable buffer of matching elements, such as a
+    // bytearray, array.array or numpy array, is filled in place. A list is filled through a temporary array of the
+    // list's length, whose elements write_back then stores in the list.
+    template <typename T>
+    struct fill_array
+    {
+        explicit fill_array(PyObject* obj)
+        {
+            throw_if_pyobj_null(obj);
+
+            if constexpr (is_buffer_element_v<T>)
+            {
+                if (PyObject_CheckBuffer(obj))
+                {
+                    m_buffer.emplace(obj, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | PyBUF_WRITABLE);
+
+                    if (!is_buffer_of<T>(m_buffer->view))
+                    {
+                        throw winrt::hresult_invalid_argument();
+                    }
+
+                    m_data = static_cast<T*>(m_buffer->view.buf);
+                    m_size = static_cast<uint32_t>(m_buffer->view.len / sizeof(T));
+                    return;
+                }
+            }
+
+            if (!PyList_Check(obj))
+            {
+                throw std::invalid_argument("expected a list or writable buffer to fill");
+            }
+
+            m_list = obj;
+            m_values.resize(PyList_GET_SIZE(obj));
+            m_data = reinterpret_cast<T*>(m_values.data());
+            m_size = static_cast<uint32_t>(m_values.size());
+        }
+
+        operator winrt::array_view<T>() const noexcept
+        {
+            return { m_data, m_size };
+        }
+
+        // Called once the callee returns. A buffer already holds the elements, so only a list needs updating.
+        void write_back()
+        {
+            if (!m_list)
+            {
+                return;
+            }
+
+            for (uint32_t index = 0; index < m_size; ++index)
+            {
+                PyObject* item = converter<T>::convert(m_data[index]);
+
+                // PyList_SetItem takes the reference to item, even when it fails.
+                if (!item || PyList_SetItem(m_list, index, item) != 0)
+                {
+                    throw python_exception{};
+                }
+            }
+        }
+
+    private:
+
+        // std::vector<bool> has no data(), so bool elements are stored as bytes, which have the same layout.
+        using storage_type = std::conditional_t<std::is_same_v<T, bool>, uint8_t, T>;
+
+        std::optional<buffer_view> m_buffer;
+        std::vector<storage_type> m_values;
+        PyObject* m_list{};
+        T* m_data{};
+        uint32_t m_size{};
+    };
+
+    // A ReceiveArray, which Python takes ownership of. Arrays of buffer_format elements become a memoryview over
+    // the array's own memory; anything else is converted into a list.
+    template <typename T>
+    struct converter<winrt::com_array<T>>
+    {
+        static PyObject* convert(winrt::com_array<T>&& value) noexcept
+        {
+            if constexpr (is_buffer_element_v<T>)
+            {
+                auto buffer = PyObject_New(array_buffer, winrt_type<array_buffer>::python_type);
+
+                if (!buffer)
+                {
+                    return nullptr;
+                }
+
+                auto [size, data] = winrt::detach_abi(value);
+                buffer->data = data;
+                buffer->count = size;
+                buffer->itemsize = sizeof(T);
+                buffer->format = buffer_format<T>::value;
+
+                PyObject* view = PyMemoryView_FromObject(reinterpret_cast<PyObject*>(buffer));
+                Py_DECREF(buffer);
+                return view;
+            }
+            else
+            {
+                PyObject* list = PyList_New(value.size());
+
+                if (!list)
+                {
+                    return nullptr;
+                }
+
+                for (uint32_t index = 0; index < value.size(); ++index)
+                {
+                    PyObject* item = converter<T>::convert(value[index]);
+
+                    if (!item)
+                    {
+                        Py_DECREF(list);
+                        return nullptr;
+                    }
+
+                    PyList_SET_ITEM(list, index, item);
+                }
+
+                return list;
+            }
+        }
+    };
+
+    // Exposes the bytes of an IBuffer, for wrappers of types implementing it. The view references the wrapper,
+    // which keeps the buffer alive.
+    template <typename T>
+    int get_buffer(PyObject* exporter, T const& buffer, Py_buffer* view, int flags) noexcept
+    {
+        try
+        {
+            uint8_t* data{};
+            winrt::check_hresult(buffer.template as<winrt::impl::IBufferByteAccess>()->Buffer(&data));
+            return PyBuffer_FillInfo(view, exporter, data, static_cast<Py_ssize_t>(buffer.Length()), 0, flags);
+        }
+        catch (...)
+        {
+            view->obj = nullptr;
+            to_PyErr();
+            return -1;
+        }
+    }
+
+    // An IBuffer over the memory of a Python object supporting the buffer protocol, such as a bytearray or numpy
+    // array, so it can be passed where WinRT expects an IBuffer without a copy. The callee may write through
+    // IBufferByteAccess, so read-only objects such as bytes are copied instead. The Py_buffer, and with it a
+    // reference to the object, is held until the IBuffer is released, which may happen on any thread.
+    template <typename TBuffer>
+    struct python_buffer final :
+        winrt::implements<python_buffer<TBuffer>, TBuffer, ::Windows::Storage::Streams::IBufferByteAccess>
+    {
+        explicit python_buffer(PyObject* obj)
+        {
+            if (PyObject_GetBuffer(obj, &m_view, PyBUF_WRITABLE) == 0)
+            {
+                m_data = static_cast<uint8_t*>(m_view.buf);
+                m_capacity = static_cast<uint32_t>(m_view.len);
+            }
+            else
+            {
+                PyErr_Clear();
+                buffer_view view{ obj, PyBUF_SIMPLE };
+                m_copy.assign(static_cast<uint8_t*>(view.view.buf), static_cast<uint8_t*>(view.view.buf) + view.view.len);
+                m_data = m_copy.data();
+                m_capacity = static_cast<uint32_t>(m_copy.size());
+            }
+
+            m_length = m_capacity;
+        }
+
+        ~python_buffer()
+        {
+            if (m_view.obj)
+            {
+                PyGILState_STATE state = PyGILState_Ensure();
+                PyBuffer_Release(&m_view);
+                PyGILState_Release(state);
+            }
+        }
+
+        uint32_t Capacity() const noexcept
+        {
+            return m_capacity;
+        }
+
+        uint32_t Length() const noexcept
+        {
+            return m_length;
+        }
+
+        void Length(uint32_t value)
+        {
+            if (value > m_capacity)
+            {
+                throw winrt::hresult_invalid_argument();
+            }
+
+            m_length = value;
+        }
+
+        HRESULT __stdcall Buffer(uint8_t** value) noexcept final
+        {
+            *value = m_data;
+            return S_OK;
+        }
+
+    private:
+
+        Py_buffer m_view{};
+        std::vector<uint8_t> m_copy;
+        uint8_t* m_data{};
+        uint32_t m_capacity{};
+        uint32_t m_length{};
+    };
+
+    // The converter for IBuffer, which the namespace declaring it specializes. Besides wrappers of WinRT buffers,
+    // it accepts any object supporting the buffer protocol.
+    template <typename TBuffer>
+    struct buffer_converter
+    {
+        static PyObject* convert(TBuffer const& instance) noexcept
+        {
+            return wrap(instance);
+        }
+
+        static TBuffer convert_to(PyObject* obj)
+        {
+            if (auto result = convert_interface_to<TBuffer>(obj))
+            {
+                return result.value();
+            }
+
+            if (PyObject_CheckBuffer(obj))
+            {
+                return winrt::make<python_buffer<TBuffer>>(obj);
+            }
+
+            throw winrt::hresult_invalid_argument();
+        }
+    };
+
+    // PyType_FromSpec only accepts the Py_bf_getbuffer slot from Python 3.9, so types exporting a buffer leave it
+    // out of their slots before that and call this once the type is created.
+    inline void set_getbuffer(PyObject* type_object, getbufferproc getbuffer) noexcept
+    {
+#if PY_VERSION_HEX < 0x03090000
+        reinterpret_cast<PyHeapTypeObject*>(type_object)->as_buffer.bf_getbuffer = getbuffer;
+#else
+        (void)type_object;
+        (void)getbuffer;
+#endif
+    }
+
     template<typename T>
     PyObject* convert(T const& instance)
     {
         return converter<T>::convert(instance);
     }
 
+    // Takes over the array's memory, leaving it empty. Received arrays are converted once, after the call.
+    template<typename T>
+    PyObject* convert(winrt::com_array<T>& value)
+    {
+        return converter<winrt::com_array<T>>::convert(std::move(value));
+    }
+
+    inline PyObject* get_arg(PyObject* args, int index)
+    {
+        return PyTuple_GetItem(args, index);
+    }
+
+    inline PyObject* get_arg(PyObject* const* args, int index)
+    {
+        return args[index];
+    }
+
     template<typename T>
     auto convert_to(PyObject* args, int index)
     {
         return converter<T>::convert_to(PyTuple_GetItem(args, index));
     }
+
+    template<typename T>
+    auto convert_to(PyObject* const* args, int index)
+    {
+        return converter<T>::convert_to(args[index]);
+    }
+
+    // Fetches a collection's elements with GetMany, iterator_batch_size at a time, and hands them to Python one by
+    // one. Stepping the IIterator with MoveNext and Current would take two ABI calls per element.
+    template <typename T>
+    struct batched_iterator final : iterator_source
+    {
+        explicit batched_iterator(winrt::Windows::Foundation::Collections::IIterator<T> const& iterator) :
+            m_iterator(iterator)
+        {
+        }
+
+        PyObject* next() noexcept override
+        {
+            try
+            {
+                if (m_index == m_count)
+                {
+                    if (m_values.size() == 0)
+                    {
+                        m_values = winrt::com_array<T>(iterator_batch_size, empty_value());
+                    }
+
+                    m_count = m_iterator.GetMany(m_values);
+                    m_index = 0;
+
+                    if (m_count == 0)
+                    {
+                        // Returning null without an exception set ends the iteration.
+                        return nullptr;
+                    }
+                }
+
+                // Moving the element out leaves its slot empty for the next GetMany, which overwrites it without
+                // releasing what was there.
+                T value = std::move(m_values[m_index++]);
+                return converter<T>::convert(value);
+            }
+            catch (...)
+            {
+                return to_PyErr();
+            }
+        }
+
+    private:
+
+        // Default constructing a runtime class would activate one.
+        static T empty_value()
+        {
+            if constexpr (std::is_constructible_v<T, std::nullptr_t>)
+            {
+                return T{ nullptr };
+            }
+            else
+            {
+                return T{};
+            }
+        }
+
+        winrt::Windows::Foundation::Collections::IIterator<T> m_iterator;
+        winrt::com_array<T> m_values;
+        uint32_t m_index{};
+        uint32_t m_count{};
+    };
+
+    // Implements __iter__ for wrappers of types implementing IIterable.
+    template <typename T>
+    PyObject* iterate(T const& iterable) noexcept
+    {
+        try
+        {
+            auto iterator = iterable.First();
+            using item_type = std::decay_t<decltype(iterator.Current())>;
+
+            auto source = std::make_unique<batched_iterator<item_type>>(iterator);
+            auto py_iterator = PyObject_New(winrt_iterator, winrt_type<winrt_iterator>::python_type);
+
+            if (!py_iterator)
+            {
+                return nullptr;
+            }
+
+            py_iterator->source = source.release();
+            return reinterpret_cast<PyObject*>(py_iterator);
+        }
+        catch (...)
+        {
+            return to_PyErr();
+        }
+    }
 }